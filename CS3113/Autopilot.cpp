@@ -0,0 +1,490 @@
+#include "Autopilot.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <climits>
+
+typedef std::chrono::steady_clock Clock;
+
+// How much a plan that hasn't landed yet is marked down for its speed, and
+// up for the fuel it has left, per pixel of distance to the nearest pad
+constexpr float SPEED_WEIGHT = 0.2f;
+constexpr float FUEL_WEIGHT  = 1.0f;
+
+Autopilot::Autopilot(const Map *map, Vector2 colliderDimensions, float gravity,
+    float deltaTime, int threadCount) : mMap {map},
+    mColliderDimensions {colliderDimensions}, mGravity {gravity},
+    mDeltaTime {deltaTime}, mThreadCount {threadCount},
+    mPredictor {map, colliderDimensions, gravity}
+{
+    if (mThreadCount <= 0) mThreadCount = (int) std::thread::hardware_concurrency();
+    if (mThreadCount <= 0) mThreadCount = 1;
+}
+
+Autopilot::~Autopilot()
+{
+    stopWorkers();
+}
+
+/**
+ * @brief Forgets the current plan and search, e.g. after the lander has been
+ * moved by something other than the autopilot.
+ */
+void Autopilot::reset()
+{
+    mPlan.clear();
+    mStepInAction  = 0;
+    mLands         = false;
+    mHasPrediction = false;
+    mSearching     = false;
+}
+
+// The UFO moves exactly the way it does in Simulation::step
+Vector2 Autopilot::ufoAt(float time) const
+{
+    return { mUfo.basePosition.x, mUfo.basePosition.y + sin(time) * mUfo.amplitude };
+}
+
+/**
+ * @brief How promising a lander that is still flying looks: close to a pad
+ * (going round walls, by the map's goal distance field), slow, and with fuel
+ * to spare.
+ */
+float Autopilot::score(const LanderState &lander) const
+{
+    float distance = mMap->sampleGoalDistance(lander.position);
+
+    // nowhere near any open tile that leads to a pad
+    if (distance == INFINITY) distance = (float) (mMap->getMapColumns() +
+        mMap->getMapRows()) * mMap->getTileSize() * 2.0f;
+
+    return -distance - SPEED_WEIGHT * GetLength(lander.velocity) +
+        FUEL_WEIGHT * lander.fuel;
+}
+
+void Autopilot::startSearch(const LanderState &root, float time)
+{
+    const int searchCount = std::min(mThreadCount, (int) ACTION_COUNT);
+
+    if ((int) mSearches.size() != searchCount)
+    {
+        stopWorkers();
+
+        mSearches.clear();
+        for (int i = 0; i < searchCount; i++)
+            mSearches.push_back(BeamSearch(mMap, mColliderDimensions, mGravity));
+
+        for (int i = 1; i < searchCount; i++)
+            mWorkers.push_back(std::thread(&Autopilot::work, this, i));
+    }
+
+    for (int i = 0; i < searchCount; i++)
+    {
+        BeamSearch &search = mSearches[i];
+        search.batch.setContinuousCollision(false);
+
+        search.layers.resize(1);
+        search.layers[0].assign(1, PlanNode { root, -1, -1, score(root) });
+        search.firstAction  = i;
+        search.actionStride = searchCount;
+        search.time         = time;
+        search.done         = root.collisionStatus != PLAYING;
+        search.winLayer     = -1;
+        search.winNode      = -1;
+    }
+
+    mSearching = true;
+}
+
+bool Autopilot::isSearchDone() const
+{
+    for (size_t i = 0; i < mSearches.size(); i++)
+        if (!mSearches[i].done) return false;
+
+    return true;
+}
+
+/**
+ * @brief Grows one beam by up to `layers` layers, stopping early at
+ * `deadline`, the depth limit, or once every plan in it has crashed. Each layer tries every action after
+ * every plan in the beam, stepping them all as one batch, then keeps the
+ * BEAM_WIDTH best still flying plus the best landing.
+ */
+void Autopilot::expand(BeamSearch *search, Clock::time_point deadline,
+    int layers) const
+{
+    for (int layer = 0; layer < layers && !search->done && Clock::now() < deadline; layer++)
+    {
+        const int depth = (int) search->layers.size() - 1;
+        const std::vector<PlanNode> &beam = search->layers.back();
+
+        search->batch.clear();
+        search->inputs.clear();
+        search->children.clear();
+
+        int firstAction = depth == 0 ? search->firstAction  : 0;
+        int stride      = depth == 0 ? search->actionStride : 1;
+
+        for (int node = 0; node < (int) beam.size(); node++)
+        {
+            if (beam[node].lander.collisionStatus != PLAYING) continue;
+
+            for (int action = firstAction; action < ACTION_COUNT; action += stride)
+            {
+                search->batch.add(beam[node].lander);
+                search->inputs.push_back(landerAction(action));
+                search->children.push_back(PlanNode { beam[node].lander, node, action, 0.0f });
+            }
+        }
+
+        if (search->children.empty()) { search->done = true; break; }
+
+        // ––––– SIMULATION ––––– //
+        float   time = search->time;
+        Vector2 ufo  = ufoAt(time);
+
+        for (int step = 0; step < ACTION_STEPS; step++)
+        {
+            if (mHasUfo)
+                search->batch.step(search->inputs.data(), mDeltaTime, &ufo,
+                    &mUfo.colliderDimensions, 1);
+            else
+                search->batch.step(search->inputs.data(), mDeltaTime);
+
+            time += mDeltaTime;
+            ufo = ufoAt(time);
+        }
+
+        search->time = time;
+
+        // ––––– SELECTION ––––– //
+        std::vector<PlanNode> &children = search->children;
+
+        int      flying = 0;
+        bool     landed = false;
+        PlanNode win;
+
+        for (int i = 0; i < (int) children.size(); i++)
+        {
+            PlanNode child = children[i];
+            child.lander = search->batch.getLander(i);
+
+            if (child.lander.collisionStatus == LOSS) continue;
+
+            if (child.lander.collisionStatus == WIN)
+            {
+                child.score = child.lander.fuel;
+                if (!landed || child.score > win.score) win = child;
+                landed = true;
+                continue;
+            }
+
+            child.score = score(child.lander);
+            children[flying++] = child;
+        }
+
+        int keep = std::min(flying, (int) BEAM_WIDTH);
+        std::nth_element(children.begin(), children.begin() + keep,
+            children.begin() + flying, [](const PlanNode &a, const PlanNode &b)
+            { return a.score > b.score; });
+
+        search->layers.push_back(std::vector<PlanNode>(children.begin(),
+            children.begin() + keep));
+
+        // the best landing rides along at the end of its layer, never expanded
+        if (landed && (search->winLayer < 0 ||
+            win.score > search->layers[search->winLayer][search->winNode].score))
+        {
+            search->layers.back().push_back(win);
+            search->winLayer = depth + 1;
+            search->winNode  = (int) search->layers.back().size() - 1;
+        }
+
+        if (depth + 1 >= MAX_DEPTH || keep == 0) search->done = true;
+    }
+}
+
+/**
+ * @brief The actions of the best plan found so far: the landing with the most
+ * fuel left if there is one, otherwise the most promising plan still flying.
+ *
+ * @return whether that plan lands.
+ */
+bool Autopilot::bestPlan(std::vector<int> *actions) const
+{
+    const BeamSearch *best = nullptr;
+    int bestLayer = -1, bestNode = -1;
+    bool lands = false;
+
+    for (size_t i = 0; i < mSearches.size(); i++)
+    {
+        const BeamSearch &search = mSearches[i];
+
+        if (search.winLayer >= 0)
+        {
+            const PlanNode &win = search.layers[search.winLayer][search.winNode];
+            if (!lands || win.score > best->layers[bestLayer][bestNode].score)
+            {
+                best = &search; bestLayer = search.winLayer; bestNode = search.winNode;
+                lands = true;
+            }
+            continue;
+        }
+        if (lands) continue;
+
+        // the deepest layer with anything still flying in it
+        int layer = (int) search.layers.size() - 1;
+        while (layer > 0 && search.layers[layer].empty()) layer--;
+        if (layer == 0) continue;
+
+        for (int node = 0; node < (int) search.layers[layer].size(); node++)
+        {
+            const PlanNode &candidate = search.layers[layer][node];
+            if (best == nullptr || layer > bestLayer || (layer == bestLayer &&
+                candidate.score > best->layers[bestLayer][bestNode].score))
+            {
+                best = &search; bestLayer = layer; bestNode = node;
+            }
+        }
+    }
+
+    actions->clear();
+    if (best == nullptr) return false;
+
+    for (int layer = bestLayer, node = bestNode; layer > 0; layer--)
+    {
+        actions->push_back(best->layers[layer][node].action);
+        node = best->layers[layer][node].parent;
+    }
+    std::reverse(actions->begin(), actions->end());
+
+    return lands;
+}
+
+/**
+ * @brief Where `lander` ends up after flying `action` for ACTION_STEPS steps
+ * from `*time`, which is advanced to match.
+ */
+LanderState Autopilot::predict(const LanderState &lander, float *time, int action)
+{
+    LanderInput input = landerAction(action);
+    Vector2     ufo   = ufoAt(*time);
+
+    mPredictor.clear();
+    mPredictor.add(lander);
+
+    for (int step = 0; step < ACTION_STEPS; step++)
+    {
+        if (mHasUfo)
+            mPredictor.step(&input, mDeltaTime, &ufo, &mUfo.colliderDimensions, 1);
+        else
+            mPredictor.step(&input, mDeltaTime);
+
+        *time += mDeltaTime;
+        ufo = ufoAt(*time);
+    }
+
+    return mPredictor.getLander(0);
+}
+
+/**
+ * @brief A worker thread's loop: sleeps until `think` starts a round, expands
+ * its search until that round's deadline, and reports back.
+ */
+void Autopilot::work(int search)
+{
+    unsigned int round = 0;
+
+    while (true)
+    {
+        Clock::time_point deadline;
+        int layers;
+        {
+            std::unique_lock<std::mutex> lock(mWorkMutex);
+            mWorkReady.wait(lock, [&] { return mStopping || mWorkRound != round; });
+            if (mStopping) return;
+
+            round    = mWorkRound;
+            deadline = mWorkDeadline;
+            layers   = mWorkLayers;
+        }
+
+        expand(&mSearches[search], deadline, layers);
+
+        std::lock_guard<std::mutex> lock(mWorkMutex);
+        if (--mWorkPending == 0) mWorkFinished.notify_one();
+    }
+}
+
+void Autopilot::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWorkMutex);
+        mStopping = true;
+    }
+    mWorkReady.notify_all();
+
+    for (size_t w = 0; w < mWorkers.size(); w++) mWorkers[w].join();
+
+    mWorkers.clear();
+    mStopping = false;
+}
+
+/**
+ * @brief Expands every search by up to `layers` layers, or until `deadline`,
+ * on all the search threads at once.
+ */
+void Autopilot::runRound(Clock::time_point deadline, int layers)
+{
+    // workers whose search is done just check in
+    {
+        std::lock_guard<std::mutex> lock(mWorkMutex);
+        mWorkDeadline = deadline;
+        mWorkLayers   = layers;
+        mWorkPending  = (int) mWorkers.size();
+        mWorkRound++;
+    }
+    mWorkReady.notify_all();
+
+    expand(&mSearches[0], deadline, layers);
+
+    std::unique_lock<std::mutex> lock(mWorkMutex);
+    mWorkFinished.wait(lock, [&] { return mWorkPending == 0; });
+}
+
+/**
+ * @brief Searches for up to `budget` seconds, spread over the search threads.
+ * Call once a frame; it returns as soon as there is nothing left to search.
+ */
+void Autopilot::think(float budget)
+{
+    if (!mSearching || isSearchDone()) return;
+
+    PROFILE_SCOPE(ZONE_AUTOPILOT);
+
+    runRound(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(budget)), INT_MAX);
+}
+
+// How far off its prediction the lander may be and still follow the plan
+constexpr float PLAN_TOLERANCE = 1.0f; // pixels, pixels per second, degrees
+
+static bool sameLander(const LanderState &a, const LanderState &b)
+{
+    return a.position.x == b.position.x && a.position.y == b.position.y &&
+        a.velocity.x == b.velocity.x && a.velocity.y == b.velocity.y &&
+        a.angle == b.angle && a.fuel == b.fuel &&
+        a.collisionStatus == b.collisionStatus;
+}
+
+static bool nearLander(const LanderState &a, const LanderState &b)
+{
+    return fabs(a.position.x - b.position.x) <= PLAN_TOLERANCE &&
+        fabs(a.position.y - b.position.y) <= PLAN_TOLERANCE &&
+        fabs(a.velocity.x - b.velocity.x) <= PLAN_TOLERANCE &&
+        fabs(a.velocity.y - b.velocity.y) <= PLAN_TOLERANCE &&
+        fabs(a.angle - b.angle) <= PLAN_TOLERANCE &&
+        a.collisionStatus == b.collisionStatus;
+}
+
+/**
+ * @brief The input for the simulation's next fixed step. Between actions this
+ * takes the best plan the search has found, predicts where its first action
+ * ends, and starts searching from there for what comes after.
+ */
+LanderInput Autopilot::nextInput(const LanderState &lander, float time)
+{
+    if (lander.collisionStatus != PLAYING) return { 0, false };
+
+    if (mStepInAction == 0)
+    {
+        if (!mHasPrediction || !nearLander(lander, mPredicted))
+        {
+            // off the plan; drift for one action while a new one is found
+            mPlan.clear();
+            mLands = false;
+        }
+        else
+        {
+            // close enough to carry on, but a landing is only certain if exact
+            if (!sameLander(lander, mPredicted)) mLands = false;
+
+            // a new plan has to land, or at least stay up as long as the old one
+            std::vector<int> actions;
+            bool lands = mSearching && bestPlan(&actions);
+            if (mSearching && (lands || actions.size() >= mPlan.size()))
+            {
+                mPlan  = actions;
+                mLands = lands;
+            }
+        }
+
+        if (mPlan.empty()) mPlan.push_back(1); // no rotation, no thrust
+
+        mPredictedTime = time;
+        mPredicted     = predict(lander, &mPredictedTime, mPlan[0]);
+        mHasPrediction = true;
+
+        mSearching = false;
+        if (!mLands && mPredicted.collisionStatus == PLAYING)
+            startSearch(mPredicted, mPredictedTime);
+    }
+
+    LanderInput input = landerAction(mPlan[0]);
+
+    if (++mStepInAction == ACTION_STEPS)
+    {
+        mStepInAction = 0;
+        mPlan.erase(mPlan.begin());
+    }
+
+    return input;
+}
+
+/**
+ * @brief Plans a whole flight from `lander` at simulation time `time` and
+ * writes it out as one input per fixed step. This flies the lander the way
+ * `nextInput` would, but lets every search run to the end (or to its first
+ * landing) instead of to a frame budget. `layerLimit` is how many beam layers
+ * each search may grow in all, over the whole flight; counting layers rather
+ * than seconds makes the result depend only on the inputs and the thread
+ * count. Drops any plan in flight.
+ *
+ * @return whether the flight lands on a pad.
+ */
+bool Autopilot::solve(const LanderState &lander, float time, int layerLimit,
+    std::vector<LanderInput> *inputs)
+{
+    reset();
+    inputs->clear();
+
+    LanderState current = lander;
+    int layersLeft = layerLimit;
+
+    while (current.collisionStatus == PLAYING && layersLeft > 0)
+    {
+        // each action's first input adopts a plan and starts the next search
+        for (int step = 0; step < ACTION_STEPS; step++)
+            inputs->push_back(nextInput(current, time));
+
+        current = mPredicted;
+        time    = mPredictedTime;
+
+        while (mSearching && !isSearchDone() && !hasLanding() && layersLeft > 0)
+        {
+            runRound(Clock::time_point::max(), 1);
+            layersLeft--;
+        }
+    }
+
+    reset();
+
+    return current.collisionStatus == WIN;
+}
+
+bool Autopilot::hasLanding() const
+{
+    for (size_t i = 0; i < mSearches.size(); i++)
+        if (mSearches[i].winLayer >= 0) return true;
+
+    return false;
+}
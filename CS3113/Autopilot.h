@@ -0,0 +1,133 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "LanderBatch.h"
+#include "Simulation.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/**
+ * Flies the lander onto a landing pad by planning with beam search over
+ * headless forward simulations (`LanderBatch`, which follows `stepLander`
+ * exactly) against the simulation's own map and UFO.
+ *
+ * A plan is a list of actions, each one input held for ACTION_STEPS fixed
+ * steps. While the lander flies the current action, the search for what to
+ * do after it runs in slices of at most `think()`'s time budget, one per
+ * frame, so it never costs more than that budget per frame. The best plan
+ * found is adopted when the action ends. Once a plan that lands is found the
+ * autopilot just flies it, preferring whichever landing saves the most fuel.
+ * If the lander ever isn't where the plan said it would be (e.g. in
+ * fixed-point or continuous-collision mode) it replans from there.
+ *
+ * Plans are steered towards the pads by the map's goal distance field, so
+ * the map needs `setDistanceFields(true)`. The search is split across
+ * threads by first action, each thread running its own beam; the threads
+ * are started with the first search and park between frames. Nothing here
+ * touches raylib.
+ */
+class Autopilot
+{
+public:
+    static constexpr int ACTION_COUNT = LANDER_ACTION_COUNT;
+    static constexpr int ACTION_STEPS = 15; // fixed steps per action
+    static constexpr int BEAM_WIDTH   = 96;
+    static constexpr int MAX_DEPTH    = 240;// actions searched ahead
+
+private:
+    struct PlanNode
+    {
+        LanderState lander;
+        int   parent; // index in the previous layer
+        int   action;
+        float score;  // higher is better
+    };
+
+    // One thread's beam, over the plans starting with its share of actions
+    struct BeamSearch
+    {
+        std::vector<std::vector<PlanNode>> layers; // [0] is the root
+        int   firstAction;
+        int   actionStride;
+        float time;        // simulation time at the newest layer
+        bool  done;
+
+        int   winLayer;    // best landing found so far, or -1
+        int   winNode;
+
+        LanderBatch              batch;
+        std::vector<LanderInput> inputs;
+        std::vector<PlanNode>    children;
+
+        BeamSearch(const Map *map, Vector2 colliderDimensions, float gravity) :
+            batch {map, colliderDimensions, gravity} { }
+    };
+
+    const Map *mMap;
+
+    Vector2  mColliderDimensions;
+    float    mGravity;
+    float    mDeltaTime;
+    bool     mHasUfo = false;
+    UfoState mUfo;
+    int      mThreadCount;
+
+    std::vector<BeamSearch> mSearches;
+    bool mSearching = false;
+
+    // Worker w expands mSearches[w + 1]; the thinking thread does the first.
+    // Each think() bumps the round and waits for every worker to finish it.
+    std::vector<std::thread> mWorkers;
+    std::mutex               mWorkMutex;
+    std::condition_variable  mWorkReady;
+    std::condition_variable  mWorkFinished;
+    unsigned int             mWorkRound   = 0;
+    int                      mWorkPending = 0;
+    int                      mWorkLayers  = 0;
+    bool                     mStopping    = false;
+    std::chrono::steady_clock::time_point mWorkDeadline;
+
+    std::vector<int> mPlan;            // actions, the current one first
+    int         mStepInAction = 0;
+    bool        mLands = false;        // the plan ends on a pad
+    bool        mHasPrediction = false;
+    LanderState mPredicted;            // where the current action ends
+    float       mPredictedTime;
+
+    LanderBatch mPredictor;
+
+    Vector2 ufoAt(float time) const;
+    float   score(const LanderState &lander) const;
+    bool    isSearchDone() const;
+    bool    hasLanding() const;
+    void    startSearch(const LanderState &root, float time);
+    void    expand(BeamSearch *search,
+        std::chrono::steady_clock::time_point deadline, int layers) const;
+    bool    bestPlan(std::vector<int> *actions) const;
+    LanderState predict(const LanderState &lander, float *time, int action);
+    void    runRound(std::chrono::steady_clock::time_point deadline, int layers);
+    void    work(int search);
+    void    stopWorkers();
+
+public:
+    Autopilot(const Map *map, Vector2 colliderDimensions, float gravity,
+        float deltaTime, int threadCount = 0);
+    ~Autopilot();
+
+    void setUfo(const UfoState &ufo) { mUfo = ufo; mHasUfo = true; }
+    void reset();
+
+    void        think(float budget);
+    LanderInput nextInput(const LanderState &lander, float time);
+    LanderInput nextInput(const Simulation &simulation)
+        { return nextInput(simulation.getLander(), simulation.getTime()); }
+    bool        solve(const LanderState &lander, float time, int layerLimit,
+        std::vector<LanderInput> *inputs);
+
+    bool hasLandingPlan() const { return mLands;        }
+    int  getThreadCount() const { return mThreadCount;  }
+};
+
+#endif // AUTOPILOT_H
@@ -1,43 +1,47 @@
 #include "Entity.h"
+#include "EntityPool.h"
 #include <algorithm>
 
 Entity::Entity() : mPosition {0.0f, 0.0f}, mMovement {0.0f, 0.0f}, 
                    mVelocity {0.0f, 0.0f}, mAcceleration {0.0f, 0.0f},
                    mScale {DEFAULT_SIZE, DEFAULT_SIZE},
                    mColliderDimensions {DEFAULT_SIZE, DEFAULT_SIZE}, 
-                   mTexture {NULL}, mTextureType {SINGLE}, mAngle {0.0f},
+                   mTextureType {SINGLE}, mAngle {0.0f},
                    mSpriteSheetDimensions {}, mDirection {RIGHT}, 
-                   mAnimationAtlas {{}}, mAnimationIndices {}, mFrameSpeed {0},
+                   mAnimationAtlas {}, mAnimationIndices {}, mFrameSpeed {0},
+                   mPreviousPosition {0.0f, 0.0f}, mPreviousAngle {0.0f},
                    mEntityType {NONE} { }
 
 Entity::Entity(Vector2 position, Vector2 scale, const char *textureFilepath, 
     EntityType entityType) : mPosition {position}, mVelocity {0.0f, 0.0f}, 
     mAcceleration {0.0f, 0.0f}, mScale {scale}, mMovement {0.0f, 0.0f}, 
-    mColliderDimensions {scale}, mTexture {LoadTexture(textureFilepath)}, 
-    mTextureType {SINGLE}, mDirection {RIGHT}, mAnimationAtlas {{}}, 
+    mColliderDimensions {scale}, mTexture {loadTextureAsync(textureFilepath)}, 
+    mTextureType {SINGLE}, mDirection {RIGHT}, mAnimationAtlas {}, 
     mAnimationIndices {}, mFrameSpeed {0}, mSpeed {DEFAULT_SPEED}, 
-    mAngle {0.0f}, mEntityType {entityType} { }
+    mAngle {0.0f}, mPreviousPosition {position}, mPreviousAngle {0.0f},
+    mEntityType {entityType} { }
 
 Entity::Entity(Vector2 position, Vector2 scale, const char *textureFilepath, 
         TextureType textureType, Vector2 spriteSheetDimensions, std::map<Direction, 
         std::vector<int>> animationAtlas, EntityType entityType) : 
         mPosition {position}, mVelocity {0.0f, 0.0f}, 
         mAcceleration {0.0f, 0.0f}, mMovement { 0.0f, 0.0f }, mScale {scale},
-        mColliderDimensions {scale}, mTexture {LoadTexture(textureFilepath)}, 
+        mColliderDimensions {scale}, mTexture {loadTextureAsync(textureFilepath)}, 
         mTextureType {ATLAS}, mSpriteSheetDimensions {spriteSheetDimensions},
         mAnimationAtlas {animationAtlas}, mDirection {RIGHT},
         mAnimationIndices {animationAtlas.at(RIGHT)}, 
-        mFrameSpeed {DEFAULT_FRAME_SPEED}, mAngle { 0.0f }, 
-        mSpeed { DEFAULT_SPEED }, mEntityType {entityType} { }
+        mFrameSpeed {DEFAULT_FRAME_SPEED}, mAngle { 0.0f },
+        mSpeed { DEFAULT_SPEED }, mPreviousPosition {position},
+        mPreviousAngle {0.0f}, mEntityType {entityType} { }
 
-Entity::~Entity() { UnloadTexture(mTexture); };
-
-void Entity::checkCollisionY(Entity *collidableEntities, int collisionCheckCount)
+void Entity::checkCollisionY(const EntityPool *collidableEntities)
 {
-    for (int i = 0; i < collisionCheckCount; i++)
+    if (collidableEntities == nullptr) return;
+
+    for (int i = 0; i < collidableEntities->getActiveCount(); i++)
     {
         // STEP 1: For every entity that our player can collide with...
-        Entity *collidableEntity = &collidableEntities[i];
+        const Entity *collidableEntity = &collidableEntities->getActive(i);
         
         if (isColliding(collidableEntity))
         {
@@ -47,11 +51,13 @@ void Entity::checkCollisionY(Entity *collidableEntities, int collisionCheckCount
     }
 }
 
-void Entity::checkCollisionX(Entity *collidableEntities, int collisionCheckCount)
+void Entity::checkCollisionX(const EntityPool *collidableEntities)
 {
-    for (int i = 0; i < collisionCheckCount; i++)
+    if (collidableEntities == nullptr) return;
+
+    for (int i = 0; i < collidableEntities->getActiveCount(); i++)
     {
-        Entity *collidableEntity = &collidableEntities[i];
+        const Entity *collidableEntity = &collidableEntities->getActive(i);
         
         if (isColliding(collidableEntity))
         {            
@@ -63,115 +69,22 @@ void Entity::checkCollisionX(Entity *collidableEntities, int collisionCheckCount
 
 void Entity::checkCollisionY(Map *map)
 {
-    if (map == nullptr) return;
-
-    Vector2 topCentreProbe    = { mPosition.x, mPosition.y - (mColliderDimensions.y / 2.0f) };
-    Vector2 topLeftProbe      = { mPosition.x - (mColliderDimensions.x / 2.0f), mPosition.y - (mColliderDimensions.y / 2.0f) };
-    Vector2 topRightProbe     = { mPosition.x + (mColliderDimensions.x / 2.0f), mPosition.y - (mColliderDimensions.y / 2.0f) };
-
-    Vector2 bottomCentreProbe = { mPosition.x, mPosition.y + (mColliderDimensions.y / 2.0f) };
-    Vector2 bottomLeftProbe   = { mPosition.x - (mColliderDimensions.x / 2.0f), mPosition.y + (mColliderDimensions.y / 2.0f) };
-    Vector2 bottomRightProbe  = { mPosition.x + (mColliderDimensions.x / 2.0f), mPosition.y + (mColliderDimensions.y / 2.0f) };
-
-    // COLLISION ABOVE (moving upward)
-    int highest_colliding_tile = std::max({
-        map->getTileAt(topCentreProbe), 
-        map->getTileAt(topLeftProbe), 
-        map->getTileAt(topRightProbe)
-    });
-
-    if (highest_colliding_tile != 0){
-        if (mVelocity.y < 0.0f){
-            if (highest_colliding_tile == 2){
-                mCollisionStatus = WIN;
-            }
-            else{
-                mCollisionStatus = LOSS;
-            }
-        }
-    }
-    
-    highest_colliding_tile = std::max({
-        map->getTileAt(bottomCentreProbe),
-        map->getTileAt(bottomLeftProbe),
-        map->getTileAt(bottomRightProbe)
-    });
-
-    if (highest_colliding_tile != 0){
-        if (mVelocity.y > 0.0f){
-            if (highest_colliding_tile == 2){
-                mCollisionStatus = WIN;
-            }
-            else{
-                mCollisionStatus = LOSS;
-            }
-        }
-    }
+    mCollisionStatus = checkMapCollisionY(map, mPosition, mColliderDimensions,
+        mVelocity.y, mCollisionStatus);
 }
 
 void Entity::checkCollisionX(Map *map)
 {
-    if (map == nullptr) return;
-
-    Vector2 leftCentreProbe   = { mPosition.x - (mColliderDimensions.x / 2.0f), mPosition.y };
-    Vector2 leftTopProbe      = { mPosition.x - (mColliderDimensions.x / 2.0f), mPosition.y - (mColliderDimensions.y / 2.0f) };
-    Vector2 leftBottomProbe   = { mPosition.x - (mColliderDimensions.x / 2.0f), mPosition.y + (mColliderDimensions.y / 2.0f) };
-
-    Vector2 rightCentreProbe  = { mPosition.x + (mColliderDimensions.x / 2.0f), mPosition.y };
-    Vector2 rightTopProbe     = { mPosition.x + (mColliderDimensions.x / 2.0f), mPosition.y - (mColliderDimensions.y / 2.0f) };
-    Vector2 rightBottomProbe  = { mPosition.x + (mColliderDimensions.x / 2.0f), mPosition.y + (mColliderDimensions.y / 2.0f) };
-
-    float xOverlap = 0.0f;
-    float yOverlap = 0.0f;
-
-        // COLLISION ABOVE (moving upward)
-    int highest_colliding_tile = std::max({
-        map->getTileAt(leftCentreProbe), 
-        map->getTileAt(leftTopProbe), 
-        map->getTileAt(leftBottomProbe)
-    });
-
-    if (highest_colliding_tile != 0){
-        if (mVelocity.y < 0.0f){
-            if (highest_colliding_tile == 2){
-                mCollisionStatus = WIN;
-            }
-            else{
-                mCollisionStatus = LOSS;
-            }
-        }
-    }
-    
-    highest_colliding_tile = std::max({
-        map->getTileAt(rightCentreProbe),
-        map->getTileAt(rightTopProbe),
-        map->getTileAt(rightBottomProbe)
-    });
-
-    if (highest_colliding_tile != 0){
-        if (mVelocity.y > 0.0f){
-            if (highest_colliding_tile == 2){
-                mCollisionStatus = WIN;
-            }
-            else{
-                mCollisionStatus = LOSS;
-            }
-        }
-    }
+    mCollisionStatus = checkMapCollisionX(map, mPosition, mColliderDimensions,
+        mVelocity.y, mCollisionStatus);
 }
 
-bool Entity::isColliding(Entity *other) const 
+bool Entity::isColliding(const Entity *other) const 
 {
     if (!other->isActive() || other == this) return false;
 
-    float xDistance = fabs(mPosition.x - other->getPosition().x) - 
-        ((mColliderDimensions.x + other->getColliderDimensions().x) / 2.0f);
-    float yDistance = fabs(mPosition.y - other->getPosition().y) - 
-        ((mColliderDimensions.y + other->getColliderDimensions().y) / 2.0f);
-
-    if (xDistance < 0.0f && yDistance < 0.0f) return true;
-
-    return false;
+    return isOverlapping(mPosition, mColliderDimensions,
+        other->getPosition(), other->getColliderDimensions());
 }
 
 void Entity::animate(float deltaTime)
@@ -191,7 +104,7 @@ void Entity::animate(float deltaTime)
 }
 
 void Entity::update(float deltaTime, Entity *player, Map *map, 
-    Entity *collidableEntities, int collisionCheckCount)
+    const EntityPool *collidableEntities)
 {
     if (mEntityStatus == INACTIVE) return;
     
@@ -220,21 +133,31 @@ void Entity::update(float deltaTime, Entity *player, Map *map,
     mVelocity.y *= DRAG;
 
     mPosition.y += mVelocity.y * deltaTime;
-    checkCollisionY(collidableEntities, collisionCheckCount);
+    checkCollisionY(collidableEntities);
     checkCollisionY(map);
 
     mPosition.x += mVelocity.x * deltaTime;
-    checkCollisionX(collidableEntities, collisionCheckCount);
+    checkCollisionX(collidableEntities);
     checkCollisionX(map);
 
     if (mTextureType == ATLAS && GetLength(mMovement) != 0 && mIsCollidingBottom) 
         animate(deltaTime);
 }
 
-void Entity::render()
+/**
+ * @brief Draws the entity between its last two physics states:
+ * `interpolation` is how far into the current fixed step the frame is, from
+ * 0 (the previous state) to 1 (the current one).
+ */
+void Entity::render(float interpolation)
 {
     if(mEntityStatus == INACTIVE) return;
 
+    Vector2 position = Vector2Lerp(mPreviousPosition, mPosition, interpolation);
+    float   angle    = Lerp(mPreviousAngle, mAngle, interpolation);
+
+    // a placeholder until the real texture has been uploaded
+    const Texture2D &texture = mTexture.get();
     Rectangle textureArea;
 
     switch (mTextureType)
@@ -246,13 +169,13 @@ void Entity::render()
                 0.0f, 0.0f,
 
                 // bottom-right corner (of texture)
-                static_cast<float>(mTexture.width),
-                static_cast<float>(mTexture.height)
+                static_cast<float>(texture.width),
+                static_cast<float>(texture.height)
             };
             break;
         case ATLAS:
             textureArea = getUVRectangle(
-                &mTexture, 
+                &texture, 
                 mAnimationIndices[mCurrentFrameIndex], 
                 mSpriteSheetDimensions.x, 
                 mSpriteSheetDimensions.y
@@ -263,8 +186,8 @@ void Entity::render()
 
     // Destination rectangle – centred on gPosition
     Rectangle destinationArea = {
-        mPosition.x,
-        mPosition.y,
+        position.x,
+        position.y,
         static_cast<float>(mScale.x),
         static_cast<float>(mScale.y)
     };
@@ -277,9 +200,9 @@ void Entity::render()
 
     // Render the texture on screen
     DrawTexturePro(
-        mTexture, 
+        texture, 
         textureArea, destinationArea, originOffset,
-        mAngle, WHITE
+        angle, WHITE
     );
 
     // displayCollider();
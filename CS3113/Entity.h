@@ -1,14 +1,15 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
-#include "Map.h"
+#include "Physics.h"
+#include "TextureCache.h"
 
 enum Direction         { LEFT, UP, RIGHT, DOWN              }; 
 enum EntityStatus      { ACTIVE, INACTIVE                   };
 enum EntityType        { PLAYER, BLOCK, UFO, NONE           };
 enum BoostStatus       { BOOSTING, NEUTRAL                  };
-enum RotateDirection   { ROTATE_LEFT = -1, ROTATE_RIGHT = 1 };
-enum CollisionStatus   { PLAYING, LOSS, WIN };
+
+class EntityPool;
 
 class Entity
 {
@@ -22,7 +23,7 @@ private:
     Vector2 mScale;
     Vector2 mColliderDimensions;
     
-    Texture2D mTexture;
+    TextureHandle mTexture; // shared with every other entity using the file
     TextureType mTextureType;
     Vector2 mSpriteSheetDimensions;
     
@@ -42,6 +43,10 @@ private:
     int mSpeed;
     float mAngle;
 
+    // state as of the fixed step before last, which `render()` blends from
+    Vector2 mPreviousPosition;
+    float mPreviousAngle;
+
     bool mIsCollidingTop    = false;
     bool mIsCollidingBottom = false;
     bool mIsCollidingRight  = false;
@@ -50,12 +55,12 @@ private:
     EntityStatus mEntityStatus = ACTIVE;
     EntityType   mEntityType;
 
-    bool isColliding(Entity *other) const;
+    bool isColliding(const Entity *other) const;
 
-    void checkCollisionY(Entity *collidableEntities, int collisionCheckCount);
+    void checkCollisionY(const EntityPool *collidableEntities);
     void checkCollisionY(Map *map);
 
-    void checkCollisionX(Entity *collidableEntities, int collisionCheckCount);
+    void checkCollisionX(const EntityPool *collidableEntities);
     void checkCollisionX(Map *map);
     
     void resetColliderFlags() 
@@ -75,7 +80,7 @@ public:
     static constexpr int   DEFAULT_FRAME_SPEED   = 14;
     static constexpr int   DEFAULT_BOOST_SPEED   = 30;
     static constexpr float Y_COLLISION_THRESHOLD = 0.5f;
-    static constexpr float DRAG = 0.995f;
+    static constexpr float DRAG = LANDER_DRAG;
 
     Entity();
     Entity(Vector2 position, Vector2 scale, const char *textureFilepath, 
@@ -84,11 +89,10 @@ public:
         TextureType textureType, Vector2 spriteSheetDimensions, 
         std::map<Direction, std::vector<int>> animationAtlas, 
         EntityType entityType);
-    ~Entity();
 
     void update(float deltaTime, Entity *player, Map *map, 
-        Entity *collidableEntities, int collisionCheckCount);
-    void render();
+        const EntityPool *collidableEntities);
+    void render(float interpolation = 1.0f);
     void normaliseMovement() { Normalise(&mMovement); }
 
     void activate()   { mEntityStatus  = ACTIVE;   }
@@ -100,7 +104,7 @@ public:
         mAcceleration.y = impulse.y; 
     }
 
-    bool isActive() { return mEntityStatus == ACTIVE ? true : false; }
+    bool isActive() const { return mEntityStatus == ACTIVE ? true : false; }
 
     void moveUp()      { mMovement.y      = -1; mDirection = UP;    }
     void moveDown()    { mMovement.y      =  1; mDirection = DOWN;  }
@@ -123,7 +127,7 @@ public:
     Vector2     getScale()                 const { return mScale;                 }
     Vector2     getColliderDimensions()    const { return mScale;                 }
     Vector2     getSpriteSheetDimensions() const { return mSpriteSheetDimensions; }
-    Texture2D   getTexture()               const { return mTexture;               }
+    const TextureHandle &getTexture()      const { return mTexture;               }
     TextureType getTextureType()           const { return mTextureType;           }
     Direction   getDirection()             const { return mDirection;             }
     int         getFrameSpeed()            const { return mFrameSpeed;            }
@@ -149,7 +153,7 @@ public:
     void setScale(Vector2 newScale)
         { mScale = newScale;                       }
     void setTexture(const char *textureFilepath)
-        { mTexture = LoadTexture(textureFilepath); }
+        { mTexture = loadTextureAsync(textureFilepath); }
     void setColliderDimensions(Vector2 newDimensions) 
         { mColliderDimensions = newDimensions;     }
     void setSpriteSheetDimensions(Vector2 newDimensions) 
@@ -160,6 +164,18 @@ public:
         { mFrameSpeed = newSpeed;                  }
     void setAngle(float newAngle) 
         { mAngle = newAngle;                       }
+    void pushPhysicsState(Vector2 newPosition, float newAngle)
+    {
+        mPreviousPosition = mPosition;
+        mPreviousAngle    = mAngle;
+        mPosition         = newPosition;
+        mAngle            = newAngle;
+    }
+    void snapPhysicsState(Vector2 newPosition, float newAngle)
+    {
+        mPreviousPosition = mPosition = newPosition;
+        mPreviousAngle    = mAngle    = newAngle;
+    }
     void setEntityType(EntityType entityType)
         { mEntityType = entityType;                }
     void setDirection(Direction newDirection)
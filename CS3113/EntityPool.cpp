@@ -0,0 +1,84 @@
+#include "EntityPool.h"
+#include <utility>
+
+EntityPool::EntityPool(int capacity) : mEntities(capacity),
+    mGenerations(capacity, 1), mActivePosition(capacity, -1)
+{
+    mFreeSlots.reserve(capacity);
+    mActive.reserve(capacity);
+
+    for (int slot = capacity - 1; slot >= 0; slot--) mFreeSlots.push_back(slot);
+}
+
+/**
+ * @brief Moves `entity` into a free slot.
+ *
+ * @return its handle, or a dead one if the pool is full.
+ */
+EntityHandle EntityPool::spawn(Entity &&entity)
+{
+    if (mFreeSlots.empty()) return EntityHandle {};
+
+    int slot = mFreeSlots.back();
+    mFreeSlots.pop_back();
+
+    mEntities[slot] = std::move(entity);
+    mActivePosition[slot] = (int) mActive.size();
+    mActive.push_back(slot);
+
+    return EntityHandle { (uint32_t) slot, mGenerations[slot] };
+}
+
+/**
+ * @brief Removes the entity `handle` refers to, if it is still alive, and
+ * drops what it held (e.g. its texture). The last live entity takes its
+ * place in the active list.
+ */
+void EntityPool::despawn(EntityHandle handle)
+{
+    if (!isAlive(handle)) return;
+
+    int slot = (int) handle.index;
+    mEntities[slot] = Entity();
+
+    if (++mGenerations[slot] == 0) mGenerations[slot] = 1;
+
+    int position = mActivePosition[slot];
+    int last     = mActive.back();
+    mActive[position]      = last;
+    mActivePosition[last]  = position;
+    mActive.pop_back();
+    mActivePosition[slot]  = -1;
+
+    mFreeSlots.push_back(slot);
+}
+
+void EntityPool::clear()
+{
+    while (!mActive.empty())
+    {
+        int slot = mActive.back();
+        despawn(EntityHandle { (uint32_t) slot, mGenerations[slot] });
+    }
+}
+
+bool EntityPool::isAlive(EntityHandle handle) const
+{
+    return handle.index < mEntities.size() &&
+        mGenerations[handle.index] == handle.generation &&
+        mActivePosition[handle.index] >= 0;
+}
+
+/**
+ * @return the entity `handle` refers to, or nullptr if it has been
+ * despawned.
+ */
+Entity *EntityPool::get(EntityHandle handle)
+{
+    return isAlive(handle) ? &mEntities[handle.index] : nullptr;
+}
+
+const Entity *EntityPool::get(EntityHandle handle) const
+{
+    return isAlive(handle) ? &mEntities[handle.index] : nullptr;
+}
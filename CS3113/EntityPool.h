@@ -0,0 +1,56 @@
+#ifndef ENTITY_POOL_H
+#define ENTITY_POOL_H
+
+#include "Entity.h"
+#include <stdint.h>
+
+/**
+ * Refers to one entity in an `EntityPool`. A handle outlives its entity
+ * safely: once the entity is despawned the slot's generation moves on, and
+ * the pool treats the old handle as dead even after the slot is reused. A
+ * zeroed handle (`EntityHandle {}`) is never alive.
+ */
+struct EntityHandle
+{
+    uint32_t index;
+    uint32_t generation; // 0 is never a live generation
+};
+
+/**
+ * Fixed-capacity entity storage. Every entity lives in one contiguous array
+ * allocated up front; spawning takes a free slot off a stack and despawning
+ * puts it back, both O(1) and neither touching the heap themselves (though
+ * an entity's own members may, e.g. an animation atlas). The live entities
+ * are also kept in a dense list, in spawn order until something despawns,
+ * so going through them never visits an empty slot.
+ */
+class EntityPool
+{
+public:
+    static constexpr int DEFAULT_CAPACITY = 256;
+
+private:
+    std::vector<Entity>   mEntities;
+    std::vector<uint32_t> mGenerations;
+    std::vector<int>      mFreeSlots;      // stack
+    std::vector<int>      mActive;         // slots in use
+    std::vector<int>      mActivePosition; // each slot's index in mActive
+
+public:
+    explicit EntityPool(int capacity = DEFAULT_CAPACITY);
+
+    EntityHandle spawn(Entity &&entity);
+    void         despawn(EntityHandle handle);
+    void clear();
+
+    bool          isAlive(EntityHandle handle) const;
+    Entity       *get(EntityHandle handle);
+    const Entity *get(EntityHandle handle) const;
+
+    int           getActiveCount()  const { return (int) mActive.size();    }
+    int           getCapacity()     const { return (int) mEntities.size();  }
+    Entity       &getActive(int i)        { return mEntities[mActive[i]];   }
+    const Entity &getActive(int i)  const { return mEntities[mActive[i]];   }
+};
+
+#endif // ENTITY_POOL_H
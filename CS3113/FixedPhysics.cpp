@@ -0,0 +1,205 @@
+#include "FixedPhysics.h"
+
+// Quarter-wave sine table, TRIG_SEGMENTS segments from 0 to 90 degrees
+constexpr int TRIG_SEGMENTS = 256;
+
+static const Fixed FIXED_ROTATION_SPEED = (Fixed) LANDER_ROTATION_SPEED * FIXED_ONE;
+static const Fixed FIXED_BOOST_SPEED    = (Fixed) LANDER_BOOST_SPEED * FIXED_ONE;
+static const Fixed FIXED_DRAG           = 65208; // 0.995
+static const Fixed FIXED_FULL_TURN      = 360 * FIXED_ONE;
+
+struct TrigTable
+{
+    Fixed sine[TRIG_SEGMENTS + 1];
+
+    /**
+     * Taylor series in Q30, integer arithmetic only, so every build gets the
+     * same table whatever its libm does.
+     */
+    TrigTable()
+    {
+        const int64_t HALF_PI_Q30 = 1686629713; // π/2 * 2^30
+
+        for (int i = 0; i <= TRIG_SEGMENTS; i++)
+        {
+            int64_t x    = HALF_PI_Q30 * i / TRIG_SEGMENTS;
+            int64_t term = x;
+            int64_t sum  = x;
+
+            for (int k = 1; k <= 7; k++)
+            {
+                term = -((term * x) >> 30);
+                term = ((term * x) >> 30) / ((2 * k) * (2 * k + 1));
+                sum += term;
+            }
+
+            sine[i] = (sum + ((Fixed) 1 << 13)) >> 14; // round Q30 to Q16
+        }
+    }
+};
+
+/**
+ * @brief Sine of an angle in degrees, both in fixed point: a table lookup
+ * and a linear interpolation, within two units in the last place. Much
+ * cheaper than libm's sin, and the same on every build.
+ */
+Fixed fixedSin(Fixed degrees)
+{
+    static const TrigTable table;
+
+    Fixed angle = degrees % FIXED_FULL_TURN;
+    if (angle < 0) angle += FIXED_FULL_TURN;
+
+    // position in segments around the whole circle, with a 16-bit fraction
+    Fixed position = angle * (4 * TRIG_SEGMENTS) / 360;
+    int   segment  = (int) (position >> FIXED_SHIFT);
+    Fixed fraction = position & (FIXED_ONE - 1);
+
+    int quadrant = segment / TRIG_SEGMENTS;
+    int index    = segment % TRIG_SEGMENTS;
+
+    Fixed from, to;
+    if (quadrant % 2 == 0)
+    {
+        from = table.sine[index];
+        to   = table.sine[index + 1];
+    }
+    else
+    {
+        from = table.sine[TRIG_SEGMENTS - index];
+        to   = table.sine[TRIG_SEGMENTS - index - 1];
+    }
+
+    Fixed value = from + fixedMul(to - from, fraction);
+    return quadrant >= 2 ? -value : value;
+}
+
+Fixed fixedCos(Fixed degrees) { return fixedSin(degrees + 90 * FIXED_ONE); }
+
+static Fixed floorDivide(Fixed a, Fixed b)
+{
+    Fixed quotient = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? quotient - 1 : quotient;
+}
+
+void toFixedLander(const LanderState &lander, FixedLanderState *fixedLander)
+{
+    fixedLander->positionX     = toFixed(lander.position.x);
+    fixedLander->positionY     = toFixed(lander.position.y);
+    fixedLander->velocityX     = toFixed(lander.velocity.x);
+    fixedLander->velocityY     = toFixed(lander.velocity.y);
+    fixedLander->accelerationX = toFixed(lander.acceleration.x);
+    fixedLander->accelerationY = toFixed(lander.acceleration.y);
+    fixedLander->halfWidth     = toFixed(lander.colliderDimensions.x / 2.0f);
+    fixedLander->halfHeight    = toFixed(lander.colliderDimensions.y / 2.0f);
+    fixedLander->angle         = toFixed(lander.angle);
+    fixedLander->fuel          = toFixed(lander.fuel);
+
+    fixedLander->collisionStatus = lander.collisionStatus;
+}
+
+/**
+ * @brief Mirrors a fixed-point lander into a `LanderState`, for rendering and
+ * for anything that reads lander state as floats. Collider dimensions,
+ * rotation and boosting are left as they are.
+ */
+void fromFixedLander(const FixedLanderState &fixedLander, LanderState *lander)
+{
+    lander->position     = { fromFixed(fixedLander.positionX), fromFixed(fixedLander.positionY) };
+    lander->velocity     = { fromFixed(fixedLander.velocityX), fromFixed(fixedLander.velocityY) };
+    lander->acceleration = { fromFixed(fixedLander.accelerationX), fromFixed(fixedLander.accelerationY) };
+    lander->angle        = fromFixed(fixedLander.angle);
+    lander->fuel         = fromFixed(fixedLander.fuel);
+
+    lander->collisionStatus = fixedLander.collisionStatus;
+}
+
+/**
+ * @brief What the tiles under an inclusive box in fixed point hold, the way
+ * `Map::queryRect` would answer for the same box.
+ */
+static unsigned int queryFixed(const Map *map, Fixed left, Fixed top,
+    Fixed right, Fixed bottom)
+{
+    const Fixed tileSize      = toFixed(map->getTileSize());
+    const Fixed leftBoundary  = toFixed(map->getLeftBoundary());
+    const Fixed topBoundary   = toFixed(map->getTopBoundary());
+
+    return map->queryTiles(
+        (int) floorDivide(left - leftBoundary, tileSize),
+        (int) floorDivide(right - leftBoundary, tileSize),
+        (int) floorDivide(top - topBoundary, tileSize),
+        (int) floorDivide(bottom - topBoundary, tileSize)
+    );
+}
+
+static void collideObstacles(FixedLanderState *lander,
+    const FixedBox *obstacles, int obstacleCount)
+{
+    for (int i = 0; i < obstacleCount; i++)
+    {
+        Fixed dx = lander->positionX - obstacles[i].x;
+        Fixed dy = lander->positionY - obstacles[i].y;
+
+        if ((dx < 0 ? -dx : dx) < lander->halfWidth + obstacles[i].halfWidth &&
+            (dy < 0 ? -dy : dy) < lander->halfHeight + obstacles[i].halfHeight)
+            lander->collisionStatus = LOSS;
+    }
+}
+
+/**
+ * @brief `applyLanderInput` followed by `stepLander`, in fixed point. Edges
+ * are checked as in `checkMapCollisionY/X`, both gated on vertical velocity.
+ */
+void stepLanderFixed(FixedLanderState *lander, LanderInput input,
+    Fixed gravity, Fixed deltaTime, const Map *map,
+    const FixedBox *obstacles, int obstacleCount)
+{
+    lander->accelerationX = 0;
+    lander->accelerationY = gravity;
+    lander->angle += fixedMul(input.rotate * FIXED_ROTATION_SPEED, deltaTime);
+
+    // ––––– BOOSTING ––––– //
+    if (input.boost && lander->fuel > 0)
+    {
+        lander->accelerationX =  fixedMul(fixedSin(lander->angle), FIXED_BOOST_SPEED);
+        lander->accelerationY = -fixedMul(fixedCos(lander->angle), FIXED_BOOST_SPEED);
+        lander->fuel -= deltaTime;
+    }
+
+    lander->velocityX += fixedMul(lander->accelerationX, deltaTime);
+    lander->velocityY += fixedMul(lander->accelerationY, deltaTime);
+    lander->velocityX  = fixedMul(lander->velocityX, FIXED_DRAG);
+    lander->velocityY  = fixedMul(lander->velocityY, FIXED_DRAG);
+
+    const Fixed halfWidth  = lander->halfWidth;
+    const Fixed halfHeight = lander->halfHeight;
+
+    // ––––– Y ––––– //
+    lander->positionY += fixedMul(lander->velocityY, deltaTime);
+    collideObstacles(lander, obstacles, obstacleCount);
+
+    if (map != nullptr && lander->velocityY != 0)
+    {
+        Fixed edge = lander->velocityY < 0 ? lander->positionY - halfHeight :
+                                             lander->positionY + halfHeight;
+
+        lander->collisionStatus = resolveContact(queryFixed(map,
+            lander->positionX - halfWidth, edge, lander->positionX + halfWidth,
+            edge), lander->collisionStatus);
+    }
+
+    // ––––– X ––––– //
+    lander->positionX += fixedMul(lander->velocityX, deltaTime);
+    collideObstacles(lander, obstacles, obstacleCount);
+
+    if (map != nullptr && lander->velocityY != 0)
+    {
+        Fixed edge = lander->velocityY < 0 ? lander->positionX - halfWidth :
+                                             lander->positionX + halfWidth;
+
+        lander->collisionStatus = resolveContact(queryFixed(map,
+            edge, lander->positionY - halfHeight, edge,
+            lander->positionY + halfHeight), lander->collisionStatus);
+    }
+}
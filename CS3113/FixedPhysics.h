@@ -0,0 +1,69 @@
+#ifndef FIXED_PHYSICS_H
+#define FIXED_PHYSICS_H
+
+#include "Physics.h"
+#include <stdint.h>
+
+/**
+ * Fixed-point lander physics. Same rules as `stepLander`, but every quantity
+ * is a 64-bit integer with 16 fractional bits and trig comes from a table
+ * built with integer arithmetic, so a trajectory depends only on its inputs:
+ * not on the compiler, optimisation level, FPU or libm it was built with.
+ *
+ * Collision uses tile indices worked out in fixed point and handed to
+ * `Map::queryTiles`, so no float rounding is involved there either.
+ */
+typedef int64_t Fixed;
+
+constexpr int   FIXED_SHIFT = 16;
+constexpr Fixed FIXED_ONE   = (Fixed) 1 << FIXED_SHIFT;
+
+// Rounds to nearest; the product is exact in double, so this is too
+inline Fixed toFixed(float value)
+{
+    double scaled = (double) value * FIXED_ONE;
+    return (Fixed) (scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+inline float fromFixed(Fixed value) { return (float) ((double) value / FIXED_ONE); }
+
+// Relies on >> being an arithmetic shift, as it is on every compiler we use
+inline Fixed fixedMul(Fixed a, Fixed b) { return (a * b) >> FIXED_SHIFT; }
+
+Fixed fixedSin(Fixed degrees);
+Fixed fixedCos(Fixed degrees);
+
+// A centred box, e.g. the UFO's collider, in fixed point
+struct FixedBox
+{
+    Fixed x;
+    Fixed y;
+    Fixed halfWidth;
+    Fixed halfHeight;
+};
+
+struct FixedLanderState
+{
+    Fixed positionX;
+    Fixed positionY;
+    Fixed velocityX;
+    Fixed velocityY;
+    Fixed accelerationX;
+    Fixed accelerationY;
+    Fixed halfWidth;
+    Fixed halfHeight;
+
+    Fixed angle; // in degrees, clockwise from "up"
+    Fixed fuel;  // in seconds of thrust
+
+    CollisionStatus collisionStatus;
+};
+
+void toFixedLander(const LanderState &lander, FixedLanderState *fixedLander);
+void fromFixedLander(const FixedLanderState &fixedLander, LanderState *lander);
+
+void stepLanderFixed(FixedLanderState *lander, LanderInput input,
+    Fixed gravity, Fixed deltaTime, const Map *map,
+    const FixedBox *obstacles, int obstacleCount);
+
+#endif // FIXED_PHYSICS_H
@@ -0,0 +1,90 @@
+#include "GhostRenderer.h"
+
+// tints by how each lander's flight has gone so far
+static const Color GHOST_FLYING  = { 255, 255, 255, 60 };
+static const Color GHOST_LANDED  = {   0, 228,  48, 90 };
+static const Color GHOST_CRASHED = { 230,  41,  55, 40 };
+
+GhostRenderer::GhostRenderer(const TextureHandle &texture, Vector2 size,
+    int capacity) :
+    mTexture {texture}, mSize {size}, mCapacity {capacity},
+    mPositionX(capacity), mPositionY(capacity), mAngle(capacity),
+    mTint(capacity), mBatch {rlLoadRenderBatch(1, capacity)} { }
+
+GhostRenderer::~GhostRenderer() { rlUnloadRenderBatch(mBatch); }
+
+void GhostRenderer::add(Vector2 position, float angle, Color tint)
+{
+    if (mCount == mCapacity) return;
+
+    mPositionX[mCount] = position.x;
+    mPositionY[mCount] = position.y;
+    mAngle[mCount]     = angle;
+    mTint[mCount]      = tint;
+    mCount++;
+}
+
+/**
+ * @brief Adds every lander in `batch`, tinted by whether it is still
+ * flying, has landed or has crashed.
+ */
+void GhostRenderer::addLanders(const LanderBatch &batch)
+{
+    const float *positionsX = batch.getPositionsX();
+    const float *positionsY = batch.getPositionsY();
+    const float *angles     = batch.getAngles();
+
+    for (int i = 0; i < batch.getSize(); i++)
+    {
+        CollisionStatus status = batch.getStatus(i);
+        add({ positionsX[i], positionsY[i] }, angles[i],
+            status == PLAYING ? GHOST_FLYING :
+            (status == WIN ? GHOST_LANDED : GHOST_CRASHED));
+    }
+}
+
+/**
+ * @brief Draws every ghost added since the last `clear`, centred on its
+ * position and rotated the way `Entity::render` rotates a sprite. Anything
+ * already queued on rlgl's default batch is drawn first.
+ */
+void GhostRenderer::render()
+{
+    if (mCount == 0) return;
+
+    const float halfWidth = mSize.x / 2.0f, halfHeight = mSize.y / 2.0f;
+
+    rlSetRenderBatchActive(&mBatch);
+    rlSetTexture(mTexture.get().id);
+    rlBegin(RL_QUADS);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+
+    for (int i = 0; i < mCount; i++)
+    {
+        float angleInRadians = mAngle[i] * DEG2RAD;
+        float cosine = cosf(angleInRadians), sine = sinf(angleInRadians);
+
+        // the half-extents, rotated
+        float acrossX = halfWidth * cosine,  acrossY = halfWidth * sine;
+        float downX   = -halfHeight * sine,  downY   = halfHeight * cosine;
+
+        float x = mPositionX[i], y = mPositionY[i];
+
+        rlColor4ub(mTint[i].r, mTint[i].g, mTint[i].b, mTint[i].a);
+
+        rlTexCoord2f(0.0f, 0.0f);
+        rlVertex2f(x - acrossX - downX, y - acrossY - downY);
+        rlTexCoord2f(0.0f, 1.0f);
+        rlVertex2f(x - acrossX + downX, y - acrossY + downY);
+        rlTexCoord2f(1.0f, 1.0f);
+        rlVertex2f(x + acrossX + downX, y + acrossY + downY);
+        rlTexCoord2f(1.0f, 0.0f);
+        rlVertex2f(x + acrossX - downX, y + acrossY - downY);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+
+    // drawing our batch in one go, and handing back the default one
+    rlSetRenderBatchActive(nullptr);
+}
@@ -0,0 +1,49 @@
+#ifndef GHOST_RENDERER_H
+#define GHOST_RENDERER_H
+
+#include "LanderBatch.h"
+#include "TextureCache.h"
+
+/**
+ * Draws up to `capacity` translucent copies of one sprite ("ghosts"), e.g.
+ * every lander in a `LanderBatch`, in a single draw call. Each frame the
+ * ghosts' positions, angles and tints are gathered into flat arrays; `render`
+ * then turns them into rotated quads in a render batch of the renderer's
+ * own, sized to hold every ghost, so that rlgl never has to flush part-way
+ * and the whole lot goes to the GPU as one buffer with one texture.
+ *
+ * The texture is shared through the cache, so ghosts show the placeholder
+ * until it has loaded, like any entity.
+ */
+class GhostRenderer
+{
+private:
+    TextureHandle mTexture;
+    Vector2   mSize;
+    int       mCapacity;
+    int       mCount = 0;
+
+    std::vector<float> mPositionX;
+    std::vector<float> mPositionY;
+    std::vector<float> mAngle;   // in degrees, clockwise
+    std::vector<Color> mTint;
+
+    rlRenderBatch mBatch;
+
+public:
+    GhostRenderer(const TextureHandle &texture, Vector2 size, int capacity);
+    ~GhostRenderer();
+
+    GhostRenderer(const GhostRenderer &) = delete;
+    GhostRenderer &operator=(const GhostRenderer &) = delete;
+
+    void clear() { mCount = 0; }
+    void add(Vector2 position, float angle, Color tint);
+    void addLanders(const LanderBatch &batch);
+    void render();
+
+    int getCount()    const { return mCount;    }
+    int getCapacity() const { return mCapacity; }
+};
+
+#endif // GHOST_RENDERER_H
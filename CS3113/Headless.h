@@ -0,0 +1,23 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+/**
+ * Stand-ins for the handful of raylib definitions the simulation core uses,
+ * so that it can be compiled with -DCS3113_HEADLESS on machines that have no
+ * raylib, window or GL context. The guards match raylib's own, so this header
+ * and raylib.h can never both define them.
+ */
+
+#if !defined(RL_VECTOR2_TYPE)
+typedef struct Vector2 {
+    float x;
+    float y;
+} Vector2;
+#define RL_VECTOR2_TYPE
+#endif
+
+#ifndef PI
+    #define PI 3.14159265358979323846f
+#endif
+
+#endif // HEADLESS_H
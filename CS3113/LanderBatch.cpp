@@ -0,0 +1,226 @@
+#include "LanderBatch.h"
+
+LanderBatch::LanderBatch(const Map *map, Vector2 colliderDimensions,
+    float gravity) : mMap {map}, mColliderDimensions {colliderDimensions},
+    mGravity {gravity}, mKernel {resolveLanderKernel(KERNEL_AUTO)} { }
+
+/**
+ * @brief Appends a lander at rest and returns its index in the batch.
+ */
+int LanderBatch::add(Vector2 position, float angle, float fuel)
+{
+    mPositionX.push_back(position.x);
+    mPositionY.push_back(position.y);
+    mVelocityX.push_back(0.0f);
+    mVelocityY.push_back(0.0f);
+    mAngle.push_back(angle);
+    mFuel.push_back(fuel);
+    mStatus.push_back(PLAYING);
+    mStepCount.push_back(0);
+
+    mTrigAngle.push_back(NAN);
+    mSin.push_back(0.0f);
+    mCos.push_back(1.0f);
+    mAccelerationX.push_back(0.0f);
+    mAccelerationY.push_back(mGravity);
+
+    mPlayingCount++;
+
+    return getSize() - 1;
+}
+
+/**
+ * @brief Appends a lander part-way through a flight, e.g. one taken from a
+ * `Simulation` or from `getLander`, and returns its index in the batch.
+ */
+int LanderBatch::add(const LanderState &lander)
+{
+    int index = add(lander.position, lander.angle, lander.fuel);
+
+    mVelocityX[index] = lander.velocity.x;
+    mVelocityY[index] = lander.velocity.y;
+    mStatus[index]    = lander.collisionStatus;
+
+    if (lander.collisionStatus != PLAYING) mPlayingCount--;
+
+    return index;
+}
+
+void LanderBatch::reset(int index, Vector2 position, float angle, float fuel)
+{
+    if (mStatus[index] != PLAYING) mPlayingCount++;
+
+    mPositionX[index] = position.x;
+    mPositionY[index] = position.y;
+    mVelocityX[index] = 0.0f;
+    mVelocityY[index] = 0.0f;
+    mAngle[index]     = angle;
+    mFuel[index]      = fuel;
+    mStatus[index]    = PLAYING;
+    mStepCount[index] = 0;
+}
+
+void LanderBatch::clear()
+{
+    mPositionX.clear();
+    mPositionY.clear();
+    mVelocityX.clear();
+    mVelocityY.clear();
+    mAngle.clear();
+    mFuel.clear();
+    mStatus.clear();
+    mStepCount.clear();
+
+    mTrigAngle.clear();
+    mSin.clear();
+    mCos.clear();
+    mAccelerationX.clear();
+    mAccelerationY.clear();
+
+    mPlayingCount = 0;
+}
+
+/**
+ * @brief Advances every lander that is still playing by one step, reading its
+ * input from `inputs[index]`. Landers that have won or lost are left alone.
+ */
+void LanderBatch::step(const LanderInput *inputs, float deltaTime,
+    const Vector2 *obstaclePositions, const Vector2 *obstacleDimensions,
+    int obstacleCount)
+{
+    const int size = getSize();
+
+    float *angles        = mAngle.data();
+    float *fuels         = mFuel.data();
+    float *trigAngles    = mTrigAngle.data();
+    float *sines         = mSin.data();
+    float *cosines       = mCos.data();
+    float *accelerationX = mAccelerationX.data();
+    float *accelerationY = mAccelerationY.data();
+
+    // ––––– ROTATION, BOOSTING ––––– //
+    for (int i = 0; i < size; i++)
+    {
+        if (mStatus[i] != PLAYING) continue;
+
+        float angle = angles[i] +
+            inputs[i].rotate * LANDER_ROTATION_SPEED * deltaTime;
+        angles[i] = angle;
+
+        accelerationX[i] = 0.0f;
+        accelerationY[i] = mGravity;
+
+        if (inputs[i].boost && fuels[i] > 0)
+        {
+            if (angle != trigAngles[i])
+            {
+                float angleInRadians = angle * PI / 180;
+                sines[i]      = sin(angleInRadians);
+                cosines[i]    = cos(angleInRadians);
+                trigAngles[i] = angle;
+            }
+
+            accelerationX[i] =  sines[i] * LANDER_BOOST_SPEED;
+            accelerationY[i] = -cosines[i] * LANDER_BOOST_SPEED;
+            fuels[i] -= deltaTime;
+        }
+    }
+
+    // ––––– INTEGRATION, COLLISION ––––– //
+    mObstacleHalfExtentsX.resize(obstacleCount);
+    mObstacleHalfExtentsY.resize(obstacleCount);
+    for (int j = 0; j < obstacleCount; j++)
+    {
+        mObstacleHalfExtentsX[j] = (mColliderDimensions.x + obstacleDimensions[j].x) / 2.0f;
+        mObstacleHalfExtentsY[j] = (mColliderDimensions.y + obstacleDimensions[j].y) / 2.0f;
+    }
+
+    LanderKernelArgs args;
+    args.positionX     = mPositionX.data();
+    args.positionY     = mPositionY.data();
+    args.velocityX     = mVelocityX.data();
+    args.velocityY     = mVelocityY.data();
+    args.accelerationX = accelerationX;
+    args.accelerationY = accelerationY;
+    args.status        = mStatus.data();
+    args.stepCount     = mStepCount.data();
+
+    args.deltaTime  = deltaTime;
+    args.halfWidth  = mColliderDimensions.x / 2.0f;
+    args.halfHeight = mColliderDimensions.y / 2.0f;
+
+    args.levelData      = mMap->getLevelData();
+    args.mapColumns     = mMap->getMapColumns();
+    args.mapRows        = mMap->getMapRows();
+    args.tileSize       = mMap->getTileSize();
+    args.leftBoundary   = mMap->getLeftBoundary();
+    args.rightBoundary  = mMap->getRightBoundary();
+    args.topBoundary    = mMap->getTopBoundary();
+    args.bottomBoundary = mMap->getBottomBoundary();
+
+    args.obstaclePositions    = obstaclePositions;
+    args.obstacleHalfExtentsX = mObstacleHalfExtentsX.data();
+    args.obstacleHalfExtentsY = mObstacleHalfExtentsY.data();
+    args.obstacleCount        = obstacleCount;
+    args.obstacleHash         = nullptr;
+
+    // The SIMD kernels read the tile array directly; streamed maps have none
+    LanderKernel kernel = mContinuousCollision || mMap->isStreamed() ?
+        KERNEL_SCALAR : mKernel;
+
+    int broadphaseMinimum = kernel == KERNEL_AVX2 ?
+        BROADPHASE_MIN_OBSTACLES_AVX2 : BROADPHASE_MIN_OBSTACLES;
+    if (obstacleCount >= broadphaseMinimum)
+    {
+        mObstacleHash.setGrid(mMap->getTileSize(),
+            { mMap->getLeftBoundary(), mMap->getTopBoundary() });
+        mObstacleHash.build(obstaclePositions, obstacleDimensions, obstacleCount);
+        args.obstacleHash = &mObstacleHash;
+    }
+
+    int processedEnd = 0;
+    int finished     = 0;
+
+    if (mContinuousCollision)
+    {
+        mPlayingCount -= landerKernelContinuous(args, mMap, 0, size);
+        return;
+    }
+
+    switch (kernel)
+    {
+        case KERNEL_AVX2:
+            finished += landerKernelAvx2(args, 0, size, &processedEnd);
+            break;
+        case KERNEL_SSE2:
+            finished += landerKernelSse2(args, 0, size, &processedEnd);
+            break;
+        default: break;
+    }
+
+    // whatever did not fill a whole vector
+    finished += landerKernelScalar(args, mMap, processedEnd, size);
+
+    mPlayingCount -= finished;
+}
+
+/**
+ * @brief Copies one lander out of the batch in the same layout the rest of the
+ * physics code uses.
+ */
+LanderState LanderBatch::getLander(int index) const
+{
+    LanderState lander;
+
+    lander.position           = getPosition(index);
+    lander.velocity           = getVelocity(index);
+    lander.acceleration       = { 0.0f, mGravity };
+    lander.colliderDimensions = mColliderDimensions;
+    lander.angle              = mAngle[index];
+    lander.rotation           = 0.0f;
+    lander.fuel               = mFuel[index];
+    lander.boosting           = false;
+    lander.collisionStatus    = getStatus(index);
+
+    return lander;
+}
@@ -0,0 +1,107 @@
+#ifndef LANDER_BATCH_H
+#define LANDER_BATCH_H
+
+#include "LanderKernels.h"
+
+/**
+ * Structure-of-arrays lander engine: position, velocity, angle, fuel and
+ * status for N landers in contiguous arrays, all stepped against one shared
+ * map in a single pass. Every lander follows exactly the same sequence as
+ * `stepLander` (and therefore `Entity::update`), so a batch of one gives the
+ * same trajectory as a `Simulation`.
+ *
+ * All landers in a batch share one collider size and one gravity.
+ *
+ * Each step runs in two passes: a scalar pass resolves rotation, thrust and
+ * fuel (caching sin/cos per lander, so trig only runs when the angle actually
+ * changed), then an integrate-and-collide kernel moves the landers and probes
+ * the map. That kernel is SSE2/AVX2 where the CPU has it, chosen at runtime,
+ * and gives the same results as the scalar one.
+ *
+ * With enough obstacles, each step first bins them into a `SpatialHash`
+ * with one cell per map tile, and a lander is only tested against the ones
+ * in the tiles it covers. Below the threshold testing all of them is
+ * quicker; it is higher for AVX2, whose brute-force loop tests eight
+ * landers against an obstacle at once.
+ *
+ * The map is only read. On a streamed map, tiles in chunks that are not
+ * resident come straight from the level file, so paging the landers'
+ * surroundings in first (`Map::streamAround`) only makes it faster. Such a
+ * map is stepped with the scalar kernel, as it has no flat tile array for
+ * the SIMD ones to gather from.
+ */
+class LanderBatch
+{
+public:
+    static constexpr int BROADPHASE_MIN_OBSTACLES      = 128;
+    static constexpr int BROADPHASE_MIN_OBSTACLES_AVX2 = 512;
+
+private:
+    const Map *mMap;
+
+    Vector2 mColliderDimensions;
+    float   mGravity;
+
+    std::vector<float> mPositionX;
+    std::vector<float> mPositionY;
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mAngle;
+    std::vector<float> mFuel;
+    std::vector<unsigned char> mStatus; // CollisionStatus
+    std::vector<int> mStepCount;
+
+    // trig cache: sin/cos of mTrigAngle, in radians
+    std::vector<float> mTrigAngle;
+    std::vector<float> mSin;
+    std::vector<float> mCos;
+
+    // per-step scratch
+    std::vector<float> mAccelerationX;
+    std::vector<float> mAccelerationY;
+    std::vector<float> mObstacleHalfExtentsX;
+    std::vector<float> mObstacleHalfExtentsY;
+    SpatialHash mObstacleHash;
+
+    LanderKernel mKernel;
+    bool mContinuousCollision = false;
+    int mPlayingCount = 0;
+
+public:
+    LanderBatch(const Map *map, Vector2 colliderDimensions, float gravity);
+
+    int  add(Vector2 position, float angle = 0.0f,
+        float fuel = LANDER_STARTING_FUEL);
+    int  add(const LanderState &lander);
+    void reset(int index, Vector2 position, float angle = 0.0f,
+        float fuel = LANDER_STARTING_FUEL);
+    void clear();
+    void setKernel(LanderKernel kernel) { mKernel = resolveLanderKernel(kernel); }
+    void setContinuousCollision(bool enabled) { mContinuousCollision = enabled; }
+
+    void step(const LanderInput *inputs, float deltaTime,
+        const Vector2 *obstaclePositions = nullptr,
+        const Vector2 *obstacleDimensions = nullptr, int obstacleCount = 0);
+
+    LanderState getLander(int index) const;
+
+    int             getSize()                const { return (int) mPositionX.size();      }
+    int             getPlayingCount()        const { return mPlayingCount;                }
+    const Map      *getMap()                 const { return mMap;                         }
+    Vector2         getColliderDimensions()  const { return mColliderDimensions;          }
+    float           getGravity()             const { return mGravity;                     }
+    LanderKernel    getKernel()              const { return mKernel;                      }
+    bool            hasContinuousCollision() const { return mContinuousCollision;         }
+    CollisionStatus getStatus(int index)     const { return (CollisionStatus) mStatus[index]; }
+    int             getStepCount(int index)  const { return mStepCount[index];            }
+    Vector2         getPosition(int index)   const { return { mPositionX[index], mPositionY[index] }; }
+    Vector2         getVelocity(int index)   const { return { mVelocityX[index], mVelocityY[index] }; }
+    float           getAngle(int index)      const { return mAngle[index];                }
+    float           getFuel(int index)       const { return mFuel[index];                 }
+
+    const float *getPositionsX() const { return mPositionX.data(); }
+    const float *getPositionsY() const { return mPositionY.data(); }
+    const float *getAngles()     const { return mAngle.data();     }
+};
+
+#endif // LANDER_BATCH_H
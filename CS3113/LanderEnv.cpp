@@ -0,0 +1,170 @@
+#include "LanderEnv.h"
+#include "Random.h"
+
+LanderEnv::LanderEnv(const Map *map, Vector2 colliderDimensions, int count,
+    float gravity, float deltaTime, int patchRadius, int maxSteps) :
+    mBatch {map, colliderDimensions, gravity}, mDeltaTime {deltaTime},
+    mCount {count}, mPatchRadius {patchRadius},
+    mObservationSize {OBSERVATION_BASE + (2 * patchRadius + 1) * (2 * patchRadius + 1)},
+    mMaxSteps {maxSteps}
+{
+    for (int i = 0; i < mCount; i++) mBatch.add(Vector2 { 0.0f, 0.0f });
+
+    mRandom.assign(mCount, 0);
+    mInputs.assign(mCount, LanderInput { 0, false });
+    mObservations.assign((size_t) mCount * mObservationSize, 0.0f);
+    mTerminalObservations.assign((size_t) mCount * mObservationSize, 0.0f);
+    mRewards.assign(mCount, 0.0f);
+    mDones.assign(mCount, 0);
+    mTruncated.assign(mCount, 0);
+
+    setSpawnArea(map->getLeftBoundary(), map->getTopBoundary(),
+        map->getRightBoundary(), map->getBottomBoundary());
+}
+
+/**
+ * @brief Where new episodes start, in world coordinates: the lander's centre
+ * is drawn uniformly from this box until its collider touches no tile.
+ */
+void LanderEnv::setSpawnArea(float left, float top, float right, float bottom)
+{
+    mSpawnLeft   = left;
+    mSpawnTop    = top;
+    mSpawnRight  = right;
+    mSpawnBottom = bottom;
+}
+
+void LanderEnv::spawn(int index)
+{
+    constexpr int ATTEMPTS = 64; // after which the last draw is used anyway
+
+    const Map *map = mBatch.getMap();
+    float halfWidth  = mBatch.getColliderDimensions().x / 2.0f;
+    float halfHeight = mBatch.getColliderDimensions().y / 2.0f;
+
+    Vector2 position;
+    for (int attempt = 0; attempt < ATTEMPTS; attempt++)
+    {
+        position = {
+            mSpawnLeft + nextUniform(&mRandom[index]) * (mSpawnRight - mSpawnLeft),
+            mSpawnTop  + nextUniform(&mRandom[index]) * (mSpawnBottom - mSpawnTop)
+        };
+
+        if (map->queryRect(position.x - halfWidth, position.y - halfHeight,
+            position.x + halfWidth, position.y + halfHeight) == CONTACT_NONE) break;
+    }
+
+    mBatch.reset(index, position);
+}
+
+void LanderEnv::observe(int index, float *observation)
+{
+    const Map *map = mBatch.getMap();
+
+    Vector2 position = mBatch.getPosition(index);
+    Vector2 velocity = mBatch.getVelocity(index);
+    float   angle    = mBatch.getAngle(index) * PI / 180;
+
+    observation[0] = position.x;
+    observation[1] = position.y;
+    observation[2] = velocity.x;
+    observation[3] = velocity.y;
+    observation[4] = sin(angle);
+    observation[5] = cos(angle);
+    observation[6] = mBatch.getFuel(index);
+
+    // ––––– TILE PATCH ––––– //
+    int column = (int) floor((position.x - map->getLeftBoundary()) / map->getTileSize());
+    int row    = (int) floor((position.y - map->getTopBoundary()) / map->getTileSize());
+
+    float *patch = observation + OBSERVATION_BASE;
+    for (int r = row - mPatchRadius; r <= row + mPatchRadius; r++)
+    {
+        for (int c = column - mPatchRadius; c <= column + mPatchRadius; c++)
+        {
+            bool onMap = c >= 0 && c < map->getMapColumns() &&
+                r >= 0 && r < map->getMapRows();
+            unsigned int tile = onMap ? map->getTile(c, r) : 1;
+
+            *patch++ = tile == 0 ? 0.0f : tile == Map::GOAL_TILE ? 1.0f : -1.0f;
+        }
+    }
+}
+
+/**
+ * @brief Starts a new episode in every environment, each from its own seed.
+ */
+void LanderEnv::reset(const uint64_t *seeds)
+{
+    for (int i = 0; i < mCount; i++)
+    {
+        mRandom[i] = seeds[i];
+        spawn(i);
+
+        mRewards[i]   = 0.0f;
+        mDones[i]     = 0;
+        mTruncated[i] = 0;
+
+        observe(i, &mObservations[(size_t) i * mObservationSize]);
+    }
+}
+
+/**
+ * @brief Steps every environment with its action, resetting any whose
+ * episode ends on this step.
+ */
+void LanderEnv::step(const int *actions)
+{
+    const Map *map = mBatch.getMap();
+
+    for (int i = 0; i < mCount; i++)
+    {
+        mInputs[i]    = landerAction(actions[i]);
+        mDones[i]     = 0;
+        mTruncated[i] = 0;
+        mRewards[i] = mBatch.getFuel(i); // fuel before the step, for now
+    }
+
+    mBatch.step(mInputs.data(), mDeltaTime);
+
+    for (int i = 0; i < mCount; i++)
+    {
+        float   fuelUsed = mRewards[i] - mBatch.getFuel(i);
+        Vector2 position = mBatch.getPosition(i);
+
+        bool offMap = position.x < map->getLeftBoundary() ||
+            position.x > map->getRightBoundary() ||
+            position.y < map->getTopBoundary() ||
+            position.y > map->getBottomBoundary();
+
+        mRewards[i] = -FUEL_COST * fuelUsed;
+
+        switch (mBatch.getStatus(i))
+        {
+            case WIN:  mRewards[i] += WIN_REWARD;  mDones[i] = 1; break;
+            case LOSS: mRewards[i] += LOSS_REWARD; mDones[i] = 1; break;
+            default:
+                if (offMap)
+                {
+                    mRewards[i] += LOSS_REWARD;
+                    mDones[i] = 1;
+                }
+                else if (mBatch.getStepCount(i) >= mMaxSteps)
+                {
+                    mDones[i]     = 1;
+                    mTruncated[i] = 1;
+                }
+                break;
+        }
+
+        float *observation = &mObservations[(size_t) i * mObservationSize];
+
+        if (mDones[i])
+        {
+            observe(i, &mTerminalObservations[(size_t) i * mObservationSize]);
+            spawn(i);
+        }
+
+        observe(i, observation);
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef LANDER_ENV_H
+#define LANDER_ENV_H
+
+#include "LanderBatch.h"
+
+/**
+ * Gym-style environment for training landing controllers: a batch of
+ * independent landers on one map, stepped together. Each step takes one
+ * action per environment (0 to LANDER_ACTION_COUNT - 1, see `landerAction`)
+ * and fills flat arrays of observations, rewards and done flags. Nothing is
+ * allocated after construction and nothing touches raylib.
+ *
+ * An observation is OBSERVATION_BASE floats (position, velocity, sin and cos
+ * of the angle, fuel) followed by the tiles in a square patch around the
+ * lander, row by row: 0 for open space, 1 for landing pad, -1 for anything
+ * else, and -1 off the map.
+ *
+ * An environment whose episode ends (landed, crashed or ran out of steps)
+ * is reset within the same `step`, vector-env style: its reward and done
+ * flag are the ending episode's, its observation is already the start of
+ * the new one, and the observation it ended on is kept in the terminal
+ * observations for bootstrapping. New episodes are drawn from each
+ * environment's own random stream, so a run depends only on the seeds and
+ * the actions.
+ *
+ * Flying off the map ends an episode as a crash. The UFO is left out: the
+ * batch steps every lander against the same obstacles, but episodes here
+ * start and end at different times, so each would need a UFO of its own.
+ */
+class LanderEnv
+{
+public:
+    static constexpr int OBSERVATION_BASE = 7;
+
+    // Rewards: the landing and crash are the ones that matter, the fuel
+    // penalty, per second of thrust, keeps landings economical
+    static constexpr float WIN_REWARD  =  100.0f;
+    static constexpr float LOSS_REWARD = -100.0f;
+    static constexpr float FUEL_COST   =    1.0f;
+
+private:
+    LanderBatch mBatch;
+    float mDeltaTime;
+    int   mCount;
+    int   mPatchRadius;
+    int   mObservationSize;
+    int   mMaxSteps;
+
+    // where episodes may start: uniformly in this box, clear of any tile
+    float mSpawnLeft, mSpawnTop, mSpawnRight, mSpawnBottom;
+
+    std::vector<uint64_t>      mRandom;   // per environment
+    std::vector<LanderInput>   mInputs;
+    std::vector<float>         mObservations;
+    std::vector<float>         mTerminalObservations; // valid where done
+    std::vector<float>         mRewards;
+    std::vector<unsigned char> mDones;
+    std::vector<unsigned char> mTruncated;
+
+    void spawn(int index);
+    void observe(int index, float *observation);
+
+public:
+    LanderEnv(const Map *map, Vector2 colliderDimensions, int count,
+        float gravity, float deltaTime, int patchRadius = 2,
+        int maxSteps = 3600);
+
+    void setSpawnArea(float left, float top, float right, float bottom);
+
+    void reset(const uint64_t *seeds);
+    void step(const int *actions);
+
+    int getCount()           const { return mCount;           }
+    int getObservationSize() const { return mObservationSize; }
+
+    const float         *getObservations() const { return mObservations.data(); }
+    const float         *getTerminalObservations() const { return mTerminalObservations.data(); }
+    const float         *getRewards()      const { return mRewards.data();      }
+    const unsigned char *getDones()        const { return mDones.data();        }
+    const unsigned char *getTruncated()    const { return mTruncated.data();    }
+
+    const LanderBatch &getBatch() const { return mBatch; }
+};
+
+#endif // LANDER_ENV_H
@@ -0,0 +1,555 @@
+#include "LanderKernels.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define LANDER_KERNELS_X86
+    #include <immintrin.h>
+#endif
+
+/**
+ * @brief Picks the kernel to run. `KERNEL_AUTO` selects the widest one the
+ * CPU supports; asking for a kernel the CPU cannot run falls back to scalar.
+ */
+LanderKernel resolveLanderKernel(LanderKernel requested)
+{
+#ifdef LANDER_KERNELS_X86
+    bool hasAvx2 = __builtin_cpu_supports("avx2");
+    bool hasSse2 = __builtin_cpu_supports("sse2");
+
+    switch (requested)
+    {
+        case KERNEL_AUTO:
+            if (hasAvx2) return KERNEL_AVX2;
+            if (hasSse2) return KERNEL_SSE2;
+            return KERNEL_SCALAR;
+        case KERNEL_AVX2: return hasAvx2 ? KERNEL_AVX2 : KERNEL_SCALAR;
+        case KERNEL_SSE2: return hasSse2 ? KERNEL_SSE2 : KERNEL_SCALAR;
+        default:          return KERNEL_SCALAR;
+    }
+#else
+    (void) requested;
+    return KERNEL_SCALAR;
+#endif
+}
+
+/**
+ * @brief Whether a lander at `position` overlaps any obstacle. With a
+ * broadphase only the obstacles near it get the exact test.
+ */
+static inline bool hitsObstacle(const LanderKernelArgs &args, Vector2 position)
+{
+    auto overlaps = [&](int j)
+    {
+        return fabs(position.x - args.obstaclePositions[j].x) - args.obstacleHalfExtentsX[j] < 0.0f &&
+               fabs(position.y - args.obstaclePositions[j].y) - args.obstacleHalfExtentsY[j] < 0.0f;
+    };
+
+    if (args.obstacleHash != nullptr)
+        return args.obstacleHash->findFirst(position,
+            { args.halfWidth * 2.0f, args.halfHeight * 2.0f }, overlaps) >= 0;
+
+    for (int j = 0; j < args.obstacleCount; j++)
+        if (overlaps(j)) return true;
+
+    return false;
+}
+
+/**
+ * @brief Reference kernel. Goes through the same `checkMapCollisionY/X` code
+ * as `Entity::update`; the SIMD kernels must agree with it bit for bit.
+ */
+int landerKernelScalar(const LanderKernelArgs &args, const Map *map,
+    int begin, int end)
+{
+    Vector2 colliderDimensions = { args.halfWidth * 2.0f, args.halfHeight * 2.0f };
+    int finished = 0;
+
+    for (int i = begin; i < end; i++)
+    {
+        if (args.status[i] != PLAYING) continue;
+
+        float vx = (args.velocityX[i] + args.accelerationX[i] * args.deltaTime) * LANDER_DRAG;
+        float vy = (args.velocityY[i] + args.accelerationY[i] * args.deltaTime) * LANDER_DRAG;
+
+        Vector2 position = { args.positionX[i], args.positionY[i] + vy * args.deltaTime };
+        CollisionStatus status = PLAYING;
+
+        if (hitsObstacle(args, position)) status = LOSS;
+        status = checkMapCollisionY(map, position, colliderDimensions, vy, status);
+
+        position.x += vx * args.deltaTime;
+        if (hitsObstacle(args, position)) status = LOSS;
+        status = checkMapCollisionX(map, position, colliderDimensions, vy, status);
+
+        args.velocityX[i] = vx;
+        args.velocityY[i] = vy;
+        args.positionX[i] = position.x;
+        args.positionY[i] = position.y;
+        args.status[i]    = status;
+        args.stepCount[i]++;
+
+        if (status != PLAYING) finished++;
+    }
+
+    return finished;
+}
+
+/**
+ * @brief Scalar kernel with swept map collision (see `stepLanderContinuous`),
+ * for stepping at timesteps where the probing kernels would tunnel.
+ */
+int landerKernelContinuous(const LanderKernelArgs &args, const Map *map,
+    int begin, int end)
+{
+    Vector2 colliderDimensions = { args.halfWidth * 2.0f, args.halfHeight * 2.0f };
+    int finished = 0;
+
+    for (int i = begin; i < end; i++)
+    {
+        if (args.status[i] != PLAYING) continue;
+
+        float vx = (args.velocityX[i] + args.accelerationX[i] * args.deltaTime) * LANDER_DRAG;
+        float vy = (args.velocityY[i] + args.accelerationY[i] * args.deltaTime) * LANDER_DRAG;
+
+        Vector2 position = { args.positionX[i], args.positionY[i] };
+        CollisionStatus status = sweepMapCollision(map, &position,
+            colliderDimensions, { 0.0f, vy * args.deltaTime }, PLAYING);
+
+        if (hitsObstacle(args, position)) status = LOSS;
+
+        if (status == PLAYING)
+        {
+            status = sweepMapCollision(map, &position, colliderDimensions,
+                { vx * args.deltaTime, 0.0f }, status);
+
+            if (hitsObstacle(args, position)) status = LOSS;
+        }
+
+        args.velocityX[i] = vx;
+        args.velocityY[i] = vy;
+        args.positionX[i] = position.x;
+        args.positionY[i] = position.y;
+        args.status[i]    = status;
+        args.stepCount[i]++;
+
+        if (status != PLAYING) finished++;
+    }
+
+    return finished;
+}
+
+#ifdef LANDER_KERNELS_X86
+
+/*
+    ----------- SSE2 -----------
+    Four landers per instruction. SSE2 has no gather, blend or integer max, so
+    those are spelt out with and/andnot/or and per-lane loads.
+*/
+static inline __m128i sse2Select(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static inline __m128i sse2Max(__m128i a, __m128i b)
+{
+    return sse2Select(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+// Column (or row) index of a coordinate plus a mask of where it is on the
+// map. Mirrors the bounds checks and floor division in Map::getTileAt; the
+// quotient is never negative once the lower bound passed, so truncation is
+// the same as floor.
+static inline __m128i sse2GridIndex(__m128 coordinate, __m128 lowerBoundary,
+    __m128 upperBoundary, __m128 tileSize, __m128i count, __m128i *valid)
+{
+    __m128i index = _mm_cvttps_epi32(
+        _mm_div_ps(_mm_sub_ps(coordinate, lowerBoundary), tileSize));
+
+    __m128 inside = _mm_and_ps(_mm_cmpge_ps(coordinate, lowerBoundary),
+                               _mm_cmple_ps(coordinate, upperBoundary));
+    *valid = _mm_and_si128(_mm_castps_si128(inside),
+                           _mm_cmplt_epi32(index, count));
+    return index;
+}
+
+static inline __m128i sse2TileAt(const LanderKernelArgs &args, __m128i column,
+    __m128i columnValid, __m128i row, __m128i rowValid)
+{
+    alignas(16) int columns[4];
+    alignas(16) int rows[4];
+    alignas(16) int valid[4];
+    alignas(16) int tile[4];
+
+    _mm_store_si128((__m128i *) columns, column);
+    _mm_store_si128((__m128i *) rows, row);
+    _mm_store_si128((__m128i *) valid, _mm_and_si128(columnValid, rowValid));
+
+    for (int k = 0; k < 4; k++)
+        tile[k] = valid[k] ?
+            (int) args.levelData[rows[k] * args.mapColumns + columns[k]] : 0;
+
+    return _mm_load_si128((const __m128i *) tile);
+}
+
+static inline __m128i sse2Resolve(__m128i status, __m128 condition,
+    __m128i highestTile)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i loss = _mm_set1_epi32(LOSS);
+    const __m128i goal = _mm_set1_epi32(2);
+
+    __m128i touching = _mm_andnot_si128(_mm_cmpeq_epi32(highestTile, zero),
+                                        _mm_castps_si128(condition));
+    // LOSS - (-1) == WIN when the tile is the landing pad
+    __m128i outcome = _mm_sub_epi32(loss, _mm_cmpeq_epi32(highestTile, goal));
+
+    return sse2Select(touching, outcome, status);
+}
+
+static inline __m128i sse2Obstacles(const LanderKernelArgs &args, __m128 x,
+    __m128 y, __m128i status)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero     = _mm_setzero_ps();
+
+    // the broadphase is per lander, so each lane asks it in turn
+    if (args.obstacleHash != nullptr)
+    {
+        alignas(16) float laneX[4];
+        alignas(16) float laneY[4];
+        alignas(16) int   hit[4];
+        _mm_store_ps(laneX, x);
+        _mm_store_ps(laneY, y);
+
+        for (int lane = 0; lane < 4; lane++)
+            hit[lane] = hitsObstacle(args, { laneX[lane], laneY[lane] }) ? -1 : 0;
+
+        return sse2Select(_mm_load_si128((const __m128i *) hit),
+            _mm_set1_epi32(LOSS), status);
+    }
+
+    for (int j = 0; j < args.obstacleCount; j++)
+    {
+        __m128 dx = _mm_sub_ps(_mm_andnot_ps(signMask,
+            _mm_sub_ps(x, _mm_set1_ps(args.obstaclePositions[j].x))),
+            _mm_set1_ps(args.obstacleHalfExtentsX[j]));
+        __m128 dy = _mm_sub_ps(_mm_andnot_ps(signMask,
+            _mm_sub_ps(y, _mm_set1_ps(args.obstaclePositions[j].y))),
+            _mm_set1_ps(args.obstacleHalfExtentsY[j]));
+        __m128 hit = _mm_and_ps(_mm_cmplt_ps(dx, zero), _mm_cmplt_ps(dy, zero));
+
+        status = sse2Select(_mm_castps_si128(hit), _mm_set1_epi32(LOSS), status);
+    }
+
+    return status;
+}
+
+int landerKernelSse2(const LanderKernelArgs &args, int begin, int end,
+    int *processedEnd)
+{
+    const __m128 deltaTime  = _mm_set1_ps(args.deltaTime);
+    const __m128 drag       = _mm_set1_ps(LANDER_DRAG);
+    const __m128 halfWidth  = _mm_set1_ps(args.halfWidth);
+    const __m128 halfHeight = _mm_set1_ps(args.halfHeight);
+    const __m128 tileSize   = _mm_set1_ps(args.tileSize);
+    const __m128 left       = _mm_set1_ps(args.leftBoundary);
+    const __m128 right      = _mm_set1_ps(args.rightBoundary);
+    const __m128 top        = _mm_set1_ps(args.topBoundary);
+    const __m128 bottom     = _mm_set1_ps(args.bottomBoundary);
+    const __m128i columns   = _mm_set1_epi32(args.mapColumns);
+    const __m128i rows      = _mm_set1_epi32(args.mapRows);
+    const __m128 zero       = _mm_setzero_ps();
+
+    int finished = 0;
+    int i = begin;
+
+    for (; i + 4 <= end; i += 4)
+    {
+        alignas(16) int lanes[4];
+        for (int k = 0; k < 4; k++) lanes[k] = args.status[i + k];
+        __m128i statusIn = _mm_load_si128((const __m128i *) lanes);
+        __m128i active   = _mm_cmpeq_epi32(statusIn, _mm_setzero_si128());
+        if (_mm_movemask_epi8(active) == 0) continue;
+
+        __m128 vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(args.velocityX + i),
+            _mm_mul_ps(_mm_loadu_ps(args.accelerationX + i), deltaTime)), drag);
+        __m128 vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(args.velocityY + i),
+            _mm_mul_ps(_mm_loadu_ps(args.accelerationY + i), deltaTime)), drag);
+
+        __m128 x = _mm_loadu_ps(args.positionX + i);
+        __m128 y = _mm_add_ps(_mm_loadu_ps(args.positionY + i), _mm_mul_ps(vy, deltaTime));
+
+        __m128 movingUp   = _mm_cmplt_ps(vy, zero);
+        __m128 movingDown = _mm_cmpgt_ps(vy, zero);
+
+        // ––––– Y ––––– //
+        __m128i status = sse2Obstacles(args, x, y, _mm_setzero_si128());
+
+        __m128i centreValid, leftValid, rightValid, topValid, bottomValid;
+        __m128i centreColumn = sse2GridIndex(x, left, right, tileSize, columns, &centreValid);
+        __m128i leftColumn   = sse2GridIndex(_mm_sub_ps(x, halfWidth), left, right, tileSize, columns, &leftValid);
+        __m128i rightColumn  = sse2GridIndex(_mm_add_ps(x, halfWidth), left, right, tileSize, columns, &rightValid);
+        __m128i topRow       = sse2GridIndex(_mm_sub_ps(y, halfHeight), top, bottom, tileSize, rows, &topValid);
+        __m128i bottomRow    = sse2GridIndex(_mm_add_ps(y, halfHeight), top, bottom, tileSize, rows, &bottomValid);
+
+        __m128i highestTile = sse2Max(sse2Max(
+            sse2TileAt(args, centreColumn, centreValid, topRow, topValid),
+            sse2TileAt(args, leftColumn, leftValid, topRow, topValid)),
+            sse2TileAt(args, rightColumn, rightValid, topRow, topValid));
+        status = sse2Resolve(status, movingUp, highestTile);
+
+        highestTile = sse2Max(sse2Max(
+            sse2TileAt(args, centreColumn, centreValid, bottomRow, bottomValid),
+            sse2TileAt(args, leftColumn, leftValid, bottomRow, bottomValid)),
+            sse2TileAt(args, rightColumn, rightValid, bottomRow, bottomValid));
+        status = sse2Resolve(status, movingDown, highestTile);
+
+        // ––––– X ––––– //
+        x = _mm_add_ps(x, _mm_mul_ps(vx, deltaTime));
+        status = sse2Obstacles(args, x, y, status);
+
+        __m128i centreRow;
+        leftColumn  = sse2GridIndex(_mm_sub_ps(x, halfWidth), left, right, tileSize, columns, &leftValid);
+        rightColumn = sse2GridIndex(_mm_add_ps(x, halfWidth), left, right, tileSize, columns, &rightValid);
+        centreRow   = sse2GridIndex(y, top, bottom, tileSize, rows, &centreValid);
+
+        highestTile = sse2Max(sse2Max(
+            sse2TileAt(args, leftColumn, leftValid, centreRow, centreValid),
+            sse2TileAt(args, leftColumn, leftValid, topRow, topValid)),
+            sse2TileAt(args, leftColumn, leftValid, bottomRow, bottomValid));
+        status = sse2Resolve(status, movingUp, highestTile);
+
+        highestTile = sse2Max(sse2Max(
+            sse2TileAt(args, rightColumn, rightValid, centreRow, centreValid),
+            sse2TileAt(args, rightColumn, rightValid, topRow, topValid)),
+            sse2TileAt(args, rightColumn, rightValid, bottomRow, bottomValid));
+        status = sse2Resolve(status, movingDown, highestTile);
+
+        // ––––– STORE (active lanes only) ––––– //
+        __m128 activeMask = _mm_castsi128_ps(active);
+        _mm_storeu_ps(args.velocityX + i, _mm_or_ps(_mm_and_ps(activeMask, vx),
+            _mm_andnot_ps(activeMask, _mm_loadu_ps(args.velocityX + i))));
+        _mm_storeu_ps(args.velocityY + i, _mm_or_ps(_mm_and_ps(activeMask, vy),
+            _mm_andnot_ps(activeMask, _mm_loadu_ps(args.velocityY + i))));
+        _mm_storeu_ps(args.positionX + i, _mm_or_ps(_mm_and_ps(activeMask, x),
+            _mm_andnot_ps(activeMask, _mm_loadu_ps(args.positionX + i))));
+        _mm_storeu_ps(args.positionY + i, _mm_or_ps(_mm_and_ps(activeMask, y),
+            _mm_andnot_ps(activeMask, _mm_loadu_ps(args.positionY + i))));
+
+        _mm_store_si128((__m128i *) lanes, sse2Select(active, status, statusIn));
+        for (int k = 0; k < 4; k++)
+        {
+            if (args.status[i + k] != PLAYING) continue;
+
+            args.status[i + k] = (unsigned char) lanes[k];
+            args.stepCount[i + k]++;
+            if (lanes[k] != PLAYING) finished++;
+        }
+    }
+
+    *processedEnd = i;
+    return finished;
+}
+
+/*
+    ----------- AVX2 -----------
+    Eight landers per instruction, with hardware gathers for the tile probes.
+*/
+#define AVX2_TARGET __attribute__((target("avx2")))
+
+AVX2_TARGET static inline __m256i avx2GridIndex(__m256 coordinate,
+    __m256 lowerBoundary, __m256 upperBoundary, __m256 tileSize,
+    __m256i count, __m256i *valid)
+{
+    __m256i index = _mm256_cvttps_epi32(
+        _mm256_div_ps(_mm256_sub_ps(coordinate, lowerBoundary), tileSize));
+
+    __m256 inside = _mm256_and_ps(
+        _mm256_cmp_ps(coordinate, lowerBoundary, _CMP_GE_OQ),
+        _mm256_cmp_ps(coordinate, upperBoundary, _CMP_LE_OQ));
+    *valid = _mm256_and_si256(_mm256_castps_si256(inside),
+                              _mm256_cmpgt_epi32(count, index));
+    return index;
+}
+
+AVX2_TARGET static inline __m256i avx2TileAt(const LanderKernelArgs &args,
+    __m256i column, __m256i columnValid, __m256i row, __m256i rowValid)
+{
+    __m256i index = _mm256_add_epi32(
+        _mm256_mullo_epi32(row, _mm256_set1_epi32(args.mapColumns)), column);
+    __m256i valid = _mm256_and_si256(columnValid, rowValid);
+
+    // Invalid lanes may hold garbage indices; the mask keeps them from loading
+    return _mm256_mask_i32gather_epi32(_mm256_setzero_si256(),
+        (const int *) args.levelData, _mm256_and_si256(index, valid), valid, 4);
+}
+
+AVX2_TARGET static inline __m256i avx2Resolve(__m256i status,
+    __m256 condition, __m256i highestTile)
+{
+    __m256i touching = _mm256_andnot_si256(
+        _mm256_cmpeq_epi32(highestTile, _mm256_setzero_si256()),
+        _mm256_castps_si256(condition));
+    // LOSS - (-1) == WIN when the tile is the landing pad
+    __m256i outcome = _mm256_sub_epi32(_mm256_set1_epi32(LOSS),
+        _mm256_cmpeq_epi32(highestTile, _mm256_set1_epi32(2)));
+
+    return _mm256_blendv_epi8(status, outcome, touching);
+}
+
+AVX2_TARGET static inline __m256i avx2Obstacles(const LanderKernelArgs &args,
+    __m256 x, __m256 y, __m256i status)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 zero     = _mm256_setzero_ps();
+
+    if (args.obstacleHash != nullptr)
+    {
+        alignas(32) float laneX[8];
+        alignas(32) float laneY[8];
+        alignas(32) int   hit[8];
+        _mm256_store_ps(laneX, x);
+        _mm256_store_ps(laneY, y);
+
+        for (int lane = 0; lane < 8; lane++)
+            hit[lane] = hitsObstacle(args, { laneX[lane], laneY[lane] }) ? -1 : 0;
+
+        return _mm256_blendv_epi8(status, _mm256_set1_epi32(LOSS),
+            _mm256_load_si256((const __m256i *) hit));
+    }
+
+    for (int j = 0; j < args.obstacleCount; j++)
+    {
+        __m256 dx = _mm256_sub_ps(_mm256_andnot_ps(signMask,
+            _mm256_sub_ps(x, _mm256_set1_ps(args.obstaclePositions[j].x))),
+            _mm256_set1_ps(args.obstacleHalfExtentsX[j]));
+        __m256 dy = _mm256_sub_ps(_mm256_andnot_ps(signMask,
+            _mm256_sub_ps(y, _mm256_set1_ps(args.obstaclePositions[j].y))),
+            _mm256_set1_ps(args.obstacleHalfExtentsY[j]));
+        __m256 hit = _mm256_and_ps(_mm256_cmp_ps(dx, zero, _CMP_LT_OQ),
+                                   _mm256_cmp_ps(dy, zero, _CMP_LT_OQ));
+
+        status = _mm256_blendv_epi8(status, _mm256_set1_epi32(LOSS),
+            _mm256_castps_si256(hit));
+    }
+
+    return status;
+}
+
+AVX2_TARGET int landerKernelAvx2(const LanderKernelArgs &args, int begin,
+    int end, int *processedEnd)
+{
+    const __m256 deltaTime  = _mm256_set1_ps(args.deltaTime);
+    const __m256 drag       = _mm256_set1_ps(LANDER_DRAG);
+    const __m256 halfWidth  = _mm256_set1_ps(args.halfWidth);
+    const __m256 halfHeight = _mm256_set1_ps(args.halfHeight);
+    const __m256 tileSize   = _mm256_set1_ps(args.tileSize);
+    const __m256 left       = _mm256_set1_ps(args.leftBoundary);
+    const __m256 right      = _mm256_set1_ps(args.rightBoundary);
+    const __m256 top        = _mm256_set1_ps(args.topBoundary);
+    const __m256 bottom     = _mm256_set1_ps(args.bottomBoundary);
+    const __m256i columns   = _mm256_set1_epi32(args.mapColumns);
+    const __m256i rows      = _mm256_set1_epi32(args.mapRows);
+    const __m256 zero       = _mm256_setzero_ps();
+
+    int finished = 0;
+    int i = begin;
+
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256i statusIn = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64((const __m128i *) (args.status + i)));
+        __m256i active = _mm256_cmpeq_epi32(statusIn, _mm256_setzero_si256());
+        if (_mm256_testz_si256(active, active)) continue;
+
+        __m256 vx = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(args.velocityX + i),
+            _mm256_mul_ps(_mm256_loadu_ps(args.accelerationX + i), deltaTime)), drag);
+        __m256 vy = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(args.velocityY + i),
+            _mm256_mul_ps(_mm256_loadu_ps(args.accelerationY + i), deltaTime)), drag);
+
+        __m256 x = _mm256_loadu_ps(args.positionX + i);
+        __m256 y = _mm256_add_ps(_mm256_loadu_ps(args.positionY + i), _mm256_mul_ps(vy, deltaTime));
+
+        __m256 movingUp   = _mm256_cmp_ps(vy, zero, _CMP_LT_OQ);
+        __m256 movingDown = _mm256_cmp_ps(vy, zero, _CMP_GT_OQ);
+
+        // ––––– Y ––––– //
+        __m256i status = avx2Obstacles(args, x, y, _mm256_setzero_si256());
+
+        __m256i centreValid, leftValid, rightValid, topValid, bottomValid;
+        __m256i centreColumn = avx2GridIndex(x, left, right, tileSize, columns, &centreValid);
+        __m256i leftColumn   = avx2GridIndex(_mm256_sub_ps(x, halfWidth), left, right, tileSize, columns, &leftValid);
+        __m256i rightColumn  = avx2GridIndex(_mm256_add_ps(x, halfWidth), left, right, tileSize, columns, &rightValid);
+        __m256i topRow       = avx2GridIndex(_mm256_sub_ps(y, halfHeight), top, bottom, tileSize, rows, &topValid);
+        __m256i bottomRow    = avx2GridIndex(_mm256_add_ps(y, halfHeight), top, bottom, tileSize, rows, &bottomValid);
+
+        __m256i highestTile = _mm256_max_epi32(_mm256_max_epi32(
+            avx2TileAt(args, centreColumn, centreValid, topRow, topValid),
+            avx2TileAt(args, leftColumn, leftValid, topRow, topValid)),
+            avx2TileAt(args, rightColumn, rightValid, topRow, topValid));
+        status = avx2Resolve(status, movingUp, highestTile);
+
+        highestTile = _mm256_max_epi32(_mm256_max_epi32(
+            avx2TileAt(args, centreColumn, centreValid, bottomRow, bottomValid),
+            avx2TileAt(args, leftColumn, leftValid, bottomRow, bottomValid)),
+            avx2TileAt(args, rightColumn, rightValid, bottomRow, bottomValid));
+        status = avx2Resolve(status, movingDown, highestTile);
+
+        // ––––– X ––––– //
+        x = _mm256_add_ps(x, _mm256_mul_ps(vx, deltaTime));
+        status = avx2Obstacles(args, x, y, status);
+
+        __m256i centreRow;
+        leftColumn  = avx2GridIndex(_mm256_sub_ps(x, halfWidth), left, right, tileSize, columns, &leftValid);
+        rightColumn = avx2GridIndex(_mm256_add_ps(x, halfWidth), left, right, tileSize, columns, &rightValid);
+        centreRow   = avx2GridIndex(y, top, bottom, tileSize, rows, &centreValid);
+
+        highestTile = _mm256_max_epi32(_mm256_max_epi32(
+            avx2TileAt(args, leftColumn, leftValid, centreRow, centreValid),
+            avx2TileAt(args, leftColumn, leftValid, topRow, topValid)),
+            avx2TileAt(args, leftColumn, leftValid, bottomRow, bottomValid));
+        status = avx2Resolve(status, movingUp, highestTile);
+
+        highestTile = _mm256_max_epi32(_mm256_max_epi32(
+            avx2TileAt(args, rightColumn, rightValid, centreRow, centreValid),
+            avx2TileAt(args, rightColumn, rightValid, topRow, topValid)),
+            avx2TileAt(args, rightColumn, rightValid, bottomRow, bottomValid));
+        status = avx2Resolve(status, movingDown, highestTile);
+
+        // ––––– STORE (active lanes only) ––––– //
+        __m256 activeMask = _mm256_castsi256_ps(active);
+        _mm256_storeu_ps(args.velocityX + i, _mm256_blendv_ps(_mm256_loadu_ps(args.velocityX + i), vx, activeMask));
+        _mm256_storeu_ps(args.velocityY + i, _mm256_blendv_ps(_mm256_loadu_ps(args.velocityY + i), vy, activeMask));
+        _mm256_storeu_ps(args.positionX + i, _mm256_blendv_ps(_mm256_loadu_ps(args.positionX + i), x, activeMask));
+        _mm256_storeu_ps(args.positionY + i, _mm256_blendv_ps(_mm256_loadu_ps(args.positionY + i), y, activeMask));
+
+        alignas(32) int lanes[8];
+        _mm256_store_si256((__m256i *) lanes, status);
+        for (int k = 0; k < 8; k++)
+        {
+            if (args.status[i + k] != PLAYING) continue;
+
+            args.status[i + k] = (unsigned char) lanes[k];
+            args.stepCount[i + k]++;
+            if (lanes[k] != PLAYING) finished++;
+        }
+    }
+
+    *processedEnd = i;
+    return finished;
+}
+
+#else
+
+int landerKernelSse2(const LanderKernelArgs &, int begin, int, int *processedEnd)
+{
+    *processedEnd = begin;
+    return 0;
+}
+
+int landerKernelAvx2(const LanderKernelArgs &, int begin, int, int *processedEnd)
+{
+    *processedEnd = begin;
+    return 0;
+}
+
+#endif // LANDER_KERNELS_X86
@@ -0,0 +1,61 @@
+#ifndef LANDER_KERNELS_H
+#define LANDER_KERNELS_H
+
+#include "Physics.h"
+#include "SpatialHash.h"
+
+enum LanderKernel { KERNEL_AUTO, KERNEL_SCALAR, KERNEL_SSE2, KERNEL_AVX2 };
+
+/**
+ * Everything the integrate-and-collide kernels need for one batch step:
+ * pointers into `LanderBatch`'s arrays plus the map's grid parameters. Angle,
+ * trig, fuel and acceleration have already been resolved per lander, so the
+ * kernels are pure arithmetic plus tile lookups.
+ */
+struct LanderKernelArgs
+{
+    float *positionX;
+    float *positionY;
+    float *velocityX;
+    float *velocityY;
+    const float *accelerationX;
+    const float *accelerationY;
+    unsigned char *status;
+    int *stepCount;
+
+    float deltaTime;
+    float halfWidth;
+    float halfHeight;
+
+    // map grid, mirrors what Map::getTileAt reads
+    const unsigned int *levelData;
+    int   mapColumns;
+    int   mapRows;
+    float tileSize;
+    float leftBoundary;
+    float rightBoundary;
+    float topBoundary;
+    float bottomBoundary;
+
+    const Vector2 *obstaclePositions;
+    const float   *obstacleHalfExtentsX; // (lander + obstacle width) / 2
+    const float   *obstacleHalfExtentsY; // (lander + obstacle height) / 2
+    int obstacleCount;
+    const SpatialHash *obstacleHash; // broadphase over them; nullptr tests them all
+};
+
+LanderKernel resolveLanderKernel(LanderKernel requested);
+
+// Each kernel steps landers [begin, end) and returns how many of them stopped
+// playing during the step. SIMD kernels handle whole vectors only and return
+// the first index they did not process through `processedEnd`.
+int landerKernelScalar(const LanderKernelArgs &args, const Map *map,
+    int begin, int end);
+int landerKernelContinuous(const LanderKernelArgs &args, const Map *map,
+    int begin, int end);
+int landerKernelSse2(const LanderKernelArgs &args, int begin, int end,
+    int *processedEnd);
+int landerKernelAvx2(const LanderKernelArgs &args, int begin, int end,
+    int *processedEnd);
+
+#endif // LANDER_KERNELS_H
@@ -0,0 +1,447 @@
+#include "LevelFile.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define LEVEL_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char LEVEL_FILE_MAGIC[4] = { 'L', 'L', 'V', 'L' };
+
+/**
+ * @brief Run-length encodes `count` tiles as (run, tile) byte pairs.
+ */
+static void encodeRuns(const unsigned char *tiles, int count,
+    std::vector<unsigned char> *out)
+{
+    out->clear();
+
+    for (int i = 0; i < count; )
+    {
+        int run = 1;
+        while (i + run < count && run < 255 && tiles[i + run] == tiles[i]) run++;
+
+        out->push_back((unsigned char) run);
+        out->push_back(tiles[i]);
+        i += run;
+    }
+}
+
+/**
+ * @brief Writes a level to `path` in the chunked format. Each chunk is stored
+ * whichever way is smallest: not at all if it is empty, run-length encoded,
+ * or raw.
+ *
+ * @return false if a tile does not fit in 8 bits or the file can't be written.
+ */
+bool writeLevelFile(const char *path, int columns, int rows,
+    const unsigned int *tiles, int chunkSize)
+{
+    if (columns <= 0 || rows <= 0 || chunkSize <= 0 ||
+        chunkSize > (int) MAX_LEVEL_CHUNK_SIZE) return false;
+
+    for (long i = 0; i < (long) columns * rows; i++)
+        if (tiles[i] > 255) return false;
+
+    const int chunkColumns = (columns + chunkSize - 1) / chunkSize;
+    const int chunkRows    = (rows + chunkSize - 1) / chunkSize;
+    const int chunkTiles   = chunkSize * chunkSize;
+
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    LevelFileHeader header;
+    memcpy(header.magic, LEVEL_FILE_MAGIC, sizeof(header.magic));
+    header.version   = LEVEL_FILE_VERSION;
+    header.columns   = (uint32_t) columns;
+    header.rows      = (uint32_t) rows;
+    header.chunkSize = (uint32_t) chunkSize;
+    header.reserved  = 0;
+
+    std::vector<LevelChunkEntry> directory(chunkColumns * chunkRows);
+    uint64_t offset = sizeof(LevelFileHeader) +
+        directory.size() * sizeof(LevelChunkEntry);
+
+    // The directory is written first as a placeholder and again at the end,
+    // once every payload's offset and size is known
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(directory.data(), sizeof(LevelChunkEntry), directory.size(), file)
+            == directory.size();
+
+    std::vector<unsigned char> chunk(chunkTiles);
+    std::vector<unsigned char> runs;
+
+    for (int chunkRow = 0; ok && chunkRow < chunkRows; chunkRow++)
+    {
+        for (int chunkColumn = 0; ok && chunkColumn < chunkColumns; chunkColumn++)
+        {
+            bool empty = true;
+
+            for (int y = 0; y < chunkSize; y++)
+            {
+                for (int x = 0; x < chunkSize; x++)
+                {
+                    int col = chunkColumn * chunkSize + x;
+                    int row = chunkRow * chunkSize + y;
+
+                    unsigned char tile = col < columns && row < rows ?
+                        (unsigned char) tiles[row * columns + col] : 0;
+
+                    chunk[y * chunkSize + x] = tile;
+                    if (tile != 0) empty = false;
+                }
+            }
+
+            LevelChunkEntry &entry = directory[chunkRow * chunkColumns + chunkColumn];
+            entry.offset = offset;
+
+            if (empty)
+            {
+                entry.size     = 0;
+                entry.encoding = CHUNK_EMPTY;
+                continue;
+            }
+
+            encodeRuns(chunk.data(), chunkTiles, &runs);
+
+            const unsigned char *payload = chunk.data();
+            entry.size     = chunkTiles;
+            entry.encoding = CHUNK_RAW;
+
+            if (runs.size() < (size_t) chunkTiles)
+            {
+                payload        = runs.data();
+                entry.size     = (uint32_t) runs.size();
+                entry.encoding = CHUNK_RLE;
+            }
+
+            ok = fwrite(payload, 1, entry.size, file) == entry.size;
+            offset += entry.size;
+        }
+    }
+
+    ok = ok && fseek(file, sizeof(LevelFileHeader), SEEK_SET) == 0 &&
+        fwrite(directory.data(), sizeof(LevelChunkEntry), directory.size(), file)
+            == directory.size();
+
+    return fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief Parses a level written out as text, the way `LEVEL_DATA` is in
+ * main.cpp: one row per line, tiles as numbers separated by commas or
+ * spaces. Blank lines are skipped, as is anything after "//".
+ */
+static bool parseLevelText(const std::vector<char> &text, int *columns,
+    int *rows, std::vector<unsigned int> *tiles)
+{
+    tiles->clear();
+    *columns = 0;
+    *rows    = 0;
+
+    const char *cursor = text.data();
+    const char *end    = text.data() + text.size();
+
+    while (cursor < end)
+    {
+        const char *lineEnd = (const char *) memchr(cursor, '\n', end - cursor);
+        if (lineEnd == nullptr) lineEnd = end;
+
+        int rowColumns = 0;
+        for (const char *c = cursor; c < lineEnd; )
+        {
+            if (*c == '/' && c + 1 < lineEnd && c[1] == '/') break;
+
+            if (*c >= '0' && *c <= '9')
+            {
+                char *numberEnd;
+                tiles->push_back((unsigned int) strtoul(c, &numberEnd, 10));
+                rowColumns++;
+                c = numberEnd;
+            }
+            else if (*c == ',' || *c == ' ' || *c == '\t' || *c == '\r') c++;
+            else return false;
+        }
+
+        if (rowColumns > 0)
+        {
+            if (*rows > 0 && rowColumns != *columns) return false;
+            *columns = rowColumns;
+            (*rows)++;
+        }
+
+        cursor = lineEnd + 1;
+    }
+
+    return *rows > 0;
+}
+
+/**
+ * @brief Reads a whole level into `tiles`, row by row: either a level file
+ * in the chunked format or a text grid (see `parseLevelText`), told apart by
+ * the chunked format's magic.
+ *
+ * @return false if the file is missing or malformed; text rows must all be
+ * the same length.
+ */
+bool readLevelFile(const char *path, int *columns, int *rows,
+    std::vector<unsigned int> *tiles)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    std::vector<char> contents;
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        contents.insert(contents.end(), buffer, buffer + read);
+    fclose(file);
+
+    if (contents.size() < sizeof(LEVEL_FILE_MAGIC) ||
+        memcmp(contents.data(), LEVEL_FILE_MAGIC, sizeof(LEVEL_FILE_MAGIC)) != 0)
+        return parseLevelText(contents, columns, rows, tiles);
+
+    LevelStream stream;
+    if (!stream.open(path)) return false;
+
+    const int chunkSize = stream.getChunkSize();
+    *columns = stream.getColumns();
+    *rows    = stream.getRows();
+    tiles->assign((size_t) *columns * *rows, 0);
+
+    std::vector<unsigned char> chunk((size_t) chunkSize * chunkSize);
+
+    for (int chunkRow = 0; chunkRow < stream.getChunkRows(); chunkRow++)
+    {
+        for (int chunkColumn = 0; chunkColumn < stream.getChunkColumns(); chunkColumn++)
+        {
+            if (!stream.decodeChunk(chunkColumn, chunkRow, chunk.data()))
+                return false;
+
+            for (int y = 0; y < chunkSize; y++)
+            {
+                int row = chunkRow * chunkSize + y;
+                if (row >= *rows) break;
+
+                for (int x = 0; x < chunkSize; x++)
+                {
+                    int col = chunkColumn * chunkSize + x;
+                    if (col >= *columns) break;
+
+                    (*tiles)[(size_t) row * *columns + col] = chunk[y * chunkSize + x];
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+LevelStream::~LevelStream() { close(); }
+
+void LevelStream::close()
+{
+#ifdef LEVEL_FILE_MMAP
+    if (mMapped) munmap((void *) mData, mSize);
+#endif
+    mBuffer.clear();
+    mBuffer.shrink_to_fit();
+
+    mData      = nullptr;
+    mSize      = 0;
+    mMapped    = false;
+    mDirectory = nullptr;
+}
+
+/**
+ * @brief Opens a level file, memory-mapping it if possible, and checks its
+ * header and directory. Nothing is decoded yet.
+ *
+ * @return false if the file is missing, truncated or not a level file. The
+ * header is not trusted: sizes that would overflow, and chunks that point
+ * past the end of the file, are rejected here.
+ */
+bool LevelStream::open(const char *path)
+{
+    close();
+
+#ifdef LEVEL_FILE_MMAP
+    int descriptor = ::open(path, O_RDONLY);
+    if (descriptor >= 0)
+    {
+        struct stat info;
+        if (fstat(descriptor, &info) == 0 && info.st_size > 0)
+        {
+            void *data = mmap(nullptr, (size_t) info.st_size, PROT_READ,
+                MAP_PRIVATE, descriptor, 0);
+
+            if (data != MAP_FAILED)
+            {
+                mData   = (const unsigned char *) data;
+                mSize   = (size_t) info.st_size;
+                mMapped = true;
+            }
+        }
+        ::close(descriptor);
+    }
+#endif
+
+    if (mData == nullptr)
+    {
+        FILE *file = fopen(path, "rb");
+        if (file == nullptr) return false;
+
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (size > 0)
+        {
+            mBuffer.resize((size_t) size);
+            if (fread(mBuffer.data(), 1, mBuffer.size(), file) == mBuffer.size())
+            {
+                mData = mBuffer.data();
+                mSize = mBuffer.size();
+            }
+        }
+        fclose(file);
+
+        if (mData == nullptr) { close(); return false; }
+    }
+
+    if (mSize < sizeof(LevelFileHeader)) { close(); return false; }
+    memcpy(&mHeader, mData, sizeof(LevelFileHeader));
+
+    if (memcmp(mHeader.magic, LEVEL_FILE_MAGIC, sizeof(mHeader.magic)) != 0 ||
+        mHeader.version != LEVEL_FILE_VERSION || mHeader.columns == 0 ||
+        mHeader.rows == 0 || mHeader.columns > INT_MAX || mHeader.rows > INT_MAX ||
+        mHeader.chunkSize == 0 || mHeader.chunkSize > MAX_LEVEL_CHUNK_SIZE)
+    {
+        close();
+        return false;
+    }
+
+    uint64_t chunkColumns = ((uint64_t) mHeader.columns + mHeader.chunkSize - 1) / mHeader.chunkSize;
+    uint64_t chunkRows    = ((uint64_t) mHeader.rows + mHeader.chunkSize - 1) / mHeader.chunkSize;
+
+    // the directory has to fit in the file, which also keeps the count an int
+    uint64_t chunkCount = chunkColumns * chunkRows;
+    if (chunkCount > (mSize - sizeof(LevelFileHeader)) / sizeof(LevelChunkEntry) ||
+        chunkCount > INT_MAX)
+    {
+        close();
+        return false;
+    }
+
+    mChunkColumns = (int) chunkColumns;
+    mChunkRows    = (int) chunkRows;
+    mDirectory    = (const LevelChunkEntry *) (mData + sizeof(LevelFileHeader));
+
+    for (int i = 0; i < (int) chunkCount; i++)
+    {
+        if (mDirectory[i].offset > mSize || mDirectory[i].size > mSize - mDirectory[i].offset)
+        {
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LevelStream::isChunkEmpty(int chunkColumn, int chunkRow) const
+{
+    return mDirectory[chunkRow * mChunkColumns + chunkColumn].encoding == CHUNK_EMPTY;
+}
+
+/**
+ * @brief Decodes one chunk into `tiles`, chunkSize * chunkSize bytes, row by
+ * row. Padding outside the level decodes as empty tiles.
+ *
+ * @return false if the chunk's payload is malformed.
+ */
+bool LevelStream::decodeChunk(int chunkColumn, int chunkRow,
+    unsigned char *tiles) const
+{
+    const LevelChunkEntry &entry = mDirectory[chunkRow * mChunkColumns + chunkColumn];
+    const int chunkTiles = (int) (mHeader.chunkSize * mHeader.chunkSize);
+    const unsigned char *payload = mData + entry.offset;
+
+    switch (entry.encoding)
+    {
+        case CHUNK_EMPTY:
+            memset(tiles, 0, chunkTiles);
+            return true;
+
+        case CHUNK_RAW:
+            if (entry.size != (uint32_t) chunkTiles) return false;
+            memcpy(tiles, payload, chunkTiles);
+            return true;
+
+        case CHUNK_RLE:
+        {
+            int written = 0;
+
+            for (uint32_t i = 0; i + 1 < entry.size; i += 2)
+            {
+                int run = payload[i];
+                if (written + run > chunkTiles) return false;
+
+                memset(tiles + written, payload[i + 1], run);
+                written += run;
+            }
+
+            return written == chunkTiles;
+        }
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief One tile, read straight from the file without decoding the rest of
+ * its chunk: 0 outside the level, and 0 if the chunk is malformed. It only
+ * reads the file, so any number of threads may call it at once.
+ */
+unsigned int LevelStream::getTile(int column, int row) const
+{
+    if (column < 0 || column >= getColumns() || row < 0 || row >= getRows())
+        return 0;
+
+    const int chunkSize  = (int) mHeader.chunkSize;
+    const int chunkTiles = chunkSize * chunkSize;
+    const LevelChunkEntry &entry = mDirectory[(row / chunkSize) * mChunkColumns +
+        column / chunkSize];
+    const unsigned char *payload = mData + entry.offset;
+
+    int index = (row % chunkSize) * chunkSize + column % chunkSize;
+
+    switch (entry.encoding)
+    {
+        case CHUNK_RAW:
+            return entry.size == (uint32_t) chunkTiles ? payload[index] : 0;
+
+        case CHUNK_RLE:
+        {
+            int covered = 0;
+
+            for (uint32_t i = 0; i + 1 < entry.size; i += 2)
+            {
+                covered += payload[i];
+                if (index < covered) return payload[i + 1];
+            }
+
+            return 0;
+        }
+
+        default:
+            return 0;
+    }
+}
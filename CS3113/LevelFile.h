@@ -0,0 +1,95 @@
+#ifndef LEVEL_FILE_H
+#define LEVEL_FILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+/**
+ * Chunked binary level format (.lvl), so that levels far bigger than the
+ * hard-coded grid can be paged in a piece at a time.
+ *
+ *   header     LevelFileHeader
+ *   directory  one LevelChunkEntry per chunk, row-major
+ *   payload    each chunk's tiles, 8 bits per tile, raw or run-length encoded
+ *
+ * Chunks are `chunkSize` tiles square; chunks on the right and bottom edges
+ * are padded with empty tiles. All integers are little-endian.
+ */
+
+enum LevelChunkEncoding
+{
+    CHUNK_EMPTY = 0, // every tile is 0, no payload
+    CHUNK_RAW   = 1, // chunkSize * chunkSize bytes
+    CHUNK_RLE   = 2  // (run length 1-255, tile) byte pairs
+};
+
+struct LevelFileHeader
+{
+    char     magic[4];  // "LLVL"
+    uint32_t version;
+    uint32_t columns;
+    uint32_t rows;
+    uint32_t chunkSize;
+    uint32_t reserved;
+};
+
+struct LevelChunkEntry
+{
+    uint64_t offset;   // from the start of the file
+    uint32_t size;     // payload bytes
+    uint32_t encoding; // LevelChunkEncoding
+};
+
+constexpr uint32_t LEVEL_FILE_VERSION       = 1;
+constexpr uint32_t DEFAULT_LEVEL_CHUNK_SIZE = 64;
+constexpr uint32_t MAX_LEVEL_CHUNK_SIZE     = 4096; // so a chunk's tile count fits an int
+
+bool writeLevelFile(const char *path, int columns, int rows,
+    const unsigned int *tiles, int chunkSize = DEFAULT_LEVEL_CHUNK_SIZE);
+bool readLevelFile(const char *path, int *columns, int *rows,
+    std::vector<unsigned int> *tiles);
+
+/**
+ * Read-only view of a level file. The file is memory-mapped where the
+ * platform allows it (read into memory otherwise), so opening even a huge
+ * level only costs reading its directory; chunks are decoded on request.
+ */
+class LevelStream
+{
+private:
+    const unsigned char *mData = nullptr;
+    size_t mSize = 0;
+
+    bool mMapped = false;
+    std::vector<unsigned char> mBuffer; // when the file could not be mapped
+
+    LevelFileHeader mHeader;
+    const LevelChunkEntry *mDirectory = nullptr;
+
+    int mChunkColumns = 0;
+    int mChunkRows    = 0;
+
+    void close();
+
+public:
+    LevelStream() = default;
+    ~LevelStream();
+
+    LevelStream(const LevelStream &) = delete;
+    LevelStream &operator=(const LevelStream &) = delete;
+
+    bool open(const char *path);
+    bool decodeChunk(int chunkColumn, int chunkRow, unsigned char *tiles) const;
+    bool isChunkEmpty(int chunkColumn, int chunkRow) const;
+    unsigned int getTile(int column, int row) const;
+
+    bool isOpen()          const { return mData != nullptr;          }
+    int  getColumns()      const { return (int) mHeader.columns;     }
+    int  getRows()         const { return (int) mHeader.rows;        }
+    int  getChunkSize()    const { return (int) mHeader.chunkSize;   }
+    int  getChunkColumns() const { return mChunkColumns;             }
+    int  getChunkRows()    const { return mChunkRows;                }
+};
+
+#endif // LEVEL_FILE_H
@@ -0,0 +1,281 @@
+#include "LevelGenerator.h"
+#include "Autopilot.h"
+#include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+constexpr unsigned int OPEN = 0, WALL = 1, ROCK = 3, ROCK_FACE = 4;
+
+LevelGenerator::LevelGenerator(int columns, int rows, int threadCount) :
+    mColumns {columns}, mRows {rows}, mThreadCount {threadCount}
+{
+    if (mThreadCount <= 0) mThreadCount = (int) std::thread::hardware_concurrency();
+    if (mThreadCount <= 0) mThreadCount = 1;
+}
+
+void LevelGenerator::setFillChance(float chance, int smoothingPasses)
+{
+    mFillChance      = chance;
+    mSmoothingPasses = smoothingPasses;
+}
+
+void LevelGenerator::setPads(int count, int width)
+{
+    mPadCount = count;
+    mPadWidth = width;
+}
+
+/**
+ * @brief Starts the lander on this tile in every level, e.g. the one the game
+ * spawns it on, instead of one drawn from the seed. It is cleared like any
+ * spawn; it should not be on the border.
+ */
+void LevelGenerator::setSpawn(int column, int row)
+{
+    mSpawnColumn = column;
+    mSpawnRow    = row;
+}
+
+/**
+ * @brief Also has every level flown by the autopilot before it is kept, with
+ * the lander's real size and physics, searching at most `layerLimit` beam
+ * layers (see `Autopilot::solve`).
+ */
+void LevelGenerator::setSolveCheck(float tileSize, Vector2 colliderDimensions,
+    float gravity, float deltaTime, int layerLimit)
+{
+    mTileSize           = tileSize;
+    mColliderDimensions = colliderDimensions;
+    mGravity            = gravity;
+    mDeltaTime          = deltaTime;
+    mSolveLayerLimit    = layerLimit;
+}
+
+/**
+ * @brief Lays out the tiles for `seed`.
+ *
+ * @return false if there was nowhere to put a single pad.
+ */
+bool LevelGenerator::carve(uint64_t seed, GeneratedLevel *level) const
+{
+    const int columns = mColumns, rows = mRows;
+    uint64_t random = seed;
+
+    level->seed    = seed;
+    level->columns = columns;
+    level->rows    = rows;
+    level->tiles.assign((size_t) columns * rows, OPEN);
+
+    std::vector<unsigned int> &tiles = level->tiles;
+    std::vector<unsigned int>  next(tiles.size());
+
+    auto isBorder = [&](int column, int row)
+    {
+        return column == 0 || column == columns - 1 || row == 0 || row == rows - 1;
+    };
+
+    // ––––– NOISE ––––– //
+    for (int row = 0; row < rows; row++)
+        for (int column = 0; column < columns; column++)
+            tiles[row * columns + column] = isBorder(column, row) ? WALL :
+                (nextUniform(&random) < mFillChance ? ROCK : OPEN);
+
+    int margin = 1 + SPAWN_CLEARANCE;
+    level->spawnColumn = margin + (int) (nextUniform(&random) *
+        std::max(columns - 2 * margin, 1));
+    level->spawnRow    = margin;
+
+    if (mSpawnColumn >= 0)
+    {
+        level->spawnColumn = mSpawnColumn;
+        level->spawnRow    = mSpawnRow;
+    }
+
+    auto clearSpawn = [&]()
+    {
+        for (int r = level->spawnRow - SPAWN_CLEARANCE; r <= level->spawnRow + SPAWN_CLEARANCE; r++)
+            for (int c = level->spawnColumn - SPAWN_CLEARANCE; c <= level->spawnColumn + SPAWN_CLEARANCE; c++)
+                if (c >= 0 && c < columns && r >= 0 && r < rows && !isBorder(c, r))
+                    tiles[r * columns + c] = OPEN;
+    };
+
+    // ––––– SMOOTHING ––––– //
+    // A tile with more than four solid neighbours fills in, one with fewer
+    // opens up; the map edge counts as solid
+    for (int pass = 0; pass < mSmoothingPasses; pass++)
+    {
+        clearSpawn();
+
+        for (int row = 0; row < rows; row++)
+        {
+            for (int column = 0; column < columns; column++)
+            {
+                int cell = row * columns + column;
+                if (isBorder(column, row)) { next[cell] = WALL; continue; }
+
+                int solid = 0;
+                for (int r = row - 1; r <= row + 1; r++)
+                    for (int c = column - 1; c <= column + 1; c++)
+                        if ((r != row || c != column) && tiles[r * columns + c] != OPEN)
+                            solid++;
+
+                next[cell] = solid > 4 ? ROCK : (solid < 4 ? OPEN : tiles[cell]);
+            }
+        }
+
+        tiles.swap(next);
+    }
+
+    clearSpawn();
+
+    // rock with open space beside it is drawn as a cliff face
+    for (int row = 1; row < rows - 1; row++)
+        for (int column = 1; column < columns - 1; column++)
+        {
+            unsigned int &tile = tiles[row * columns + column];
+            if (tile == ROCK && (tiles[row * columns + column - 1] == OPEN ||
+                tiles[row * columns + column + 1] == OPEN)) tile = ROCK_FACE;
+        }
+
+    // ––––– PADS ––––– //
+    // on interior rock, with two open tiles above every pad tile
+    std::vector<int> candidates;
+    for (int row = 3; row < rows - 1; row++)
+    {
+        for (int column = 1; column + mPadWidth <= columns - 1; column++)
+        {
+            bool fits = true;
+            for (int c = column; c < column + mPadWidth && fits; c++)
+                fits = tiles[row * columns + c] != OPEN &&
+                    tiles[(row - 1) * columns + c] == OPEN &&
+                    tiles[(row - 2) * columns + c] == OPEN;
+
+            if (fits) candidates.push_back(row * columns + column);
+        }
+    }
+
+    int pads = 0;
+    while (pads < mPadCount && !candidates.empty())
+    {
+        size_t pick = (size_t) (nextRandom(&random) % candidates.size());
+        int    cell = candidates[pick];
+        candidates[pick] = candidates.back();
+        candidates.pop_back();
+
+        // candidates that overlap an earlier pad no longer fit
+        bool fits = true;
+        for (int c = 0; c < mPadWidth && fits; c++)
+            fits = tiles[cell + c] != Map::GOAL_TILE;
+        if (!fits) continue;
+
+        for (int c = 0; c < mPadWidth; c++) tiles[cell + c] = Map::GOAL_TILE;
+        pads++;
+    }
+
+    return pads > 0;
+}
+
+/**
+ * @brief Whether a pad can be reached from the spawn tile, and if a solve
+ * check is set, whether the autopilot lands there within its search limit.
+ * Fills in the level's goal distance.
+ */
+bool LevelGenerator::isSolvable(GeneratedLevel *level) const
+{
+    Map map(level->columns, level->rows, level->tiles.data(), mTileSize,
+        { 0.0f, 0.0f });
+    map.setDistanceFields(true);
+
+    Vector2 spawn = {
+        map.getLeftBoundary() + (level->spawnColumn + 0.5f) * mTileSize,
+        map.getTopBoundary()  + (level->spawnRow    + 0.5f) * mTileSize
+    };
+
+    level->goalDistance = map.sampleGoalDistance(spawn) / mTileSize;
+    if (level->goalDistance == INFINITY) return false;
+
+    if (mSolveLayerLimit <= 0) return true;
+
+    LanderState lander;
+    lander.position           = spawn;
+    lander.velocity           = { 0.0f, 0.0f };
+    lander.acceleration       = { 0.0f, mGravity };
+    lander.colliderDimensions = mColliderDimensions;
+    lander.angle              = 0.0f;
+    lander.rotation           = 0.0f;
+    lander.fuel               = LANDER_STARTING_FUEL;
+    lander.boosting           = false;
+    lander.collisionStatus    = PLAYING;
+
+    // one thread each: the levels themselves are already spread across cores
+    Autopilot autopilot(&map, mColliderDimensions, mGravity, mDeltaTime, 1);
+    std::vector<LanderInput> inputs;
+
+    return autopilot.solve(lander, 0.0f, mSolveLayerLimit, &inputs);
+}
+
+/**
+ * @brief Generates the level for `seed`.
+ *
+ * @return whether it passed the checks; `level` is filled in either way.
+ */
+bool LevelGenerator::generate(uint64_t seed, GeneratedLevel *level) const
+{
+    return carve(seed, level) && isSolvable(level);
+}
+
+/**
+ * @brief Tries seeds from `firstSeed` upwards, across all threads, until
+ * `count` levels pass the checks or `maxAttempts` seeds (by default 100 per
+ * level wanted) have been tried. The levels kept are always the first ones
+ * to pass in seed order, whatever the thread count.
+ *
+ * @return how many levels were kept.
+ */
+int LevelGenerator::generateMany(uint64_t firstSeed, int count,
+    std::vector<GeneratedLevel> *levels, int maxAttempts) const
+{
+    if (maxAttempts <= 0) maxAttempts = count * 100;
+
+    std::atomic<int> nextAttempt {0};
+    std::atomic<int> passed {0};
+    std::vector<std::vector<GeneratedLevel>> found(mThreadCount);
+
+    // Seeds are handed out in order and every seed handed out is finished,
+    // so the first `count` to pass overall are among those found
+    auto work = [&](int thread)
+    {
+        GeneratedLevel level;
+
+        while (passed.load(std::memory_order_relaxed) < count)
+        {
+            int attempt = nextAttempt.fetch_add(1, std::memory_order_relaxed);
+            if (attempt >= maxAttempts) break;
+
+            if (!generate(firstSeed + attempt, &level)) continue;
+
+            found[thread].push_back(level);
+            passed.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (int thread = 1; thread < mThreadCount; thread++)
+        workers.emplace_back(work, thread);
+    work(0);
+    for (std::thread &worker : workers) worker.join();
+
+    levels->clear();
+    for (std::vector<GeneratedLevel> &threadLevels : found)
+        for (GeneratedLevel &level : threadLevels)
+            levels->push_back(std::move(level));
+
+    std::sort(levels->begin(), levels->end(),
+        [](const GeneratedLevel &a, const GeneratedLevel &b)
+        { return a.seed < b.seed; });
+
+    if ((int) levels->size() > count) levels->resize(count);
+
+    return (int) levels->size();
+}
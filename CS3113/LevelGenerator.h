@@ -0,0 +1,78 @@
+#ifndef LEVEL_GENERATOR_H
+#define LEVEL_GENERATOR_H
+
+#include "Physics.h"
+
+/**
+ * A generated level: a row-major tile grid in the same form as `LEVEL_DATA`
+ * (0 open, 1 wall, 2 landing pad, 3 and 4 rock), and where the lander starts.
+ */
+struct GeneratedLevel
+{
+    uint64_t seed;
+    int columns;
+    int rows;
+    std::vector<unsigned int> tiles;
+
+    int   spawnColumn;  // the lander starts centred on this open tile
+    int   spawnRow;
+    float goalDistance; // shortest path from the spawn tile to a pad, in tiles
+};
+
+/**
+ * Seeded cave levels. Random rock is smoothed into caves by a cellular
+ * automaton inside a wall border, the lander is given a clear patch near the
+ * top (or round the tile `setSpawn` picked), and pads are laid on rock
+ * floors with headroom above. The same seed and settings always give the
+ * same level.
+ *
+ * A level is only kept if a pad can be reached from the spawn tile through
+ * open tiles (by the map's goal distance field) and, if `setSolveCheck` set
+ * a search limit, if the autopilot then actually lands there in a headless
+ * flight. `generateMany` spreads seeds across threads. Nothing here touches
+ * raylib.
+ */
+class LevelGenerator
+{
+public:
+    static constexpr int SPAWN_CLEARANCE = 1; // open tiles kept round the spawn tile
+
+private:
+    int   mColumns;
+    int   mRows;
+    int   mThreadCount;
+
+    float mFillChance      = 0.45f; // of each tile starting as rock
+    int   mSmoothingPasses = 4;
+    int   mPadCount        = 2;
+    int   mPadWidth        = 2;
+    int   mSpawnColumn     = -1;    // -1: anywhere along the top
+    int   mSpawnRow        = -1;
+
+    // for the check levels are built and flown with
+    float   mTileSize           = 40.0f;
+    Vector2 mColliderDimensions = { 40.0f, 40.0f };
+    float   mGravity            = 10.0f;
+    float   mDeltaTime          = 1.0f / 60.0f;
+    int     mSolveLayerLimit    = 0;    // 0 only checks reachability
+
+    bool carve(uint64_t seed, GeneratedLevel *level) const;
+    bool isSolvable(GeneratedLevel *level) const;
+
+public:
+    LevelGenerator(int columns, int rows, int threadCount = 0);
+
+    void setFillChance(float chance, int smoothingPasses = 4);
+    void setPads(int count, int width);
+    void setSpawn(int column, int row);
+    void setSolveCheck(float tileSize, Vector2 colliderDimensions,
+        float gravity, float deltaTime, int layerLimit);
+
+    bool generate(uint64_t seed, GeneratedLevel *level) const;
+    int  generateMany(uint64_t firstSeed, int count,
+        std::vector<GeneratedLevel> *levels, int maxAttempts = 0) const;
+
+    int getThreadCount() const { return mThreadCount; }
+};
+
+#endif // LEVEL_GENERATOR_H
@@ -0,0 +1,110 @@
+#include "LevelWatcher.h"
+#include <sys/stat.h>
+
+#ifdef __linux__
+#define LEVEL_WATCHER_INOTIFY
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+bool LevelWatcher::readFileInfo(int64_t *modified, int64_t *size) const
+{
+    struct stat info;
+    if (stat(mPath.c_str(), &info) != 0) return false;
+
+    *modified = (int64_t) info.st_mtime;
+    *size     = (int64_t) info.st_size;
+    return true;
+}
+
+/**
+ * @brief Starts watching `path`, which need not exist yet; creating it
+ * counts as a change.
+ *
+ * @return false if the file's directory can't be watched and the file can't
+ * be found either.
+ */
+bool LevelWatcher::watch(const char *path)
+{
+    stop();
+
+    mPath = path;
+    size_t slash = mPath.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." :
+        (slash == 0 ? "/" : mPath.substr(0, slash));
+    mFileName = slash == std::string::npos ? mPath : mPath.substr(slash + 1);
+
+#ifdef LEVEL_WATCHER_INOTIFY
+    mInotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (mInotify >= 0)
+    {
+        // a finished write in place, or a finished file renamed over it
+        mWatch = inotify_add_watch(mInotify, directory.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO);
+        if (mWatch >= 0) return true;
+
+        close(mInotify);
+        mInotify = -1;
+    }
+#else
+    (void) directory;
+#endif
+
+    mSize = -1;
+    return readFileInfo(&mModified, &mSize);
+}
+
+/**
+ * @brief Whether the file has been saved since the last check. Several
+ * saves in between count once.
+ */
+bool LevelWatcher::hasChanged()
+{
+    if (mPath.empty()) return false;
+
+#ifdef LEVEL_WATCHER_INOTIFY
+    if (mInotify >= 0)
+    {
+        alignas(struct inotify_event) char buffer[4096];
+        bool changed = false;
+        ssize_t length;
+
+        while ((length = read(mInotify, buffer, sizeof(buffer))) > 0)
+        {
+            for (char *next = buffer; next < buffer + length; )
+            {
+                const struct inotify_event *event = (const struct inotify_event *) next;
+                if (event->len > 0 && mFileName == event->name) changed = true;
+
+                next += sizeof(struct inotify_event) + event->len;
+            }
+        }
+
+        return changed;
+    }
+#endif
+
+    int64_t modified, size;
+    if (!readFileInfo(&modified, &size))
+    {
+        mSize = -1; // so that it counts as changed when it comes back
+        return false;
+    }
+
+    if (modified == mModified && size == mSize) return false;
+
+    mModified = modified;
+    mSize     = size;
+    return true;
+}
+
+void LevelWatcher::stop()
+{
+#ifdef LEVEL_WATCHER_INOTIFY
+    if (mInotify >= 0) close(mInotify);
+#endif
+    mInotify = -1;
+    mWatch   = -1;
+    mPath.clear();
+    mFileName.clear();
+}
@@ -0,0 +1,46 @@
+#ifndef LEVEL_WATCHER_H
+#define LEVEL_WATCHER_H
+
+#include <stdint.h>
+#include <string>
+
+/**
+ * Tells when a level file has been saved, for reloading it while the game
+ * runs. On Linux it listens to inotify on the file's directory, since many
+ * editors save by writing a new file and renaming it over the old one, which
+ * a watch on the file itself would not survive. Elsewhere it compares the
+ * file's modification time and size on every check.
+ *
+ * Checking never blocks, so it can be done once a frame.
+ */
+class LevelWatcher
+{
+private:
+    std::string mPath;
+    std::string mFileName; // the part of mPath inotify reports
+
+    int mInotify = -1;
+    int mWatch   = -1;
+
+    // the fallback's last view of the file
+    int64_t mModified = 0;
+    int64_t mSize     = -1;
+
+    bool readFileInfo(int64_t *modified, int64_t *size) const;
+
+public:
+    LevelWatcher() = default;
+    ~LevelWatcher() { stop(); }
+
+    LevelWatcher(const LevelWatcher &) = delete;
+    LevelWatcher &operator=(const LevelWatcher &) = delete;
+
+    bool watch(const char *path);
+    bool hasChanged();
+    void stop();
+
+    bool        isWatching() const { return !mPath.empty(); }
+    const char *getPath()    const { return mPath.c_str();  }
+};
+
+#endif // LEVEL_WATCHER_H
@@ -0,0 +1,81 @@
+#ifndef LOCK_FREE_H
+#define LOCK_FREE_H
+
+#include <atomic>
+
+/**
+ * Bounded single-producer, single-consumer queue. One thread may push and
+ * one other thread may pop, concurrently, without locks; `push` fails rather
+ * than blocks when the queue is full.
+ */
+template <typename T, unsigned int CAPACITY>
+class SpscQueue
+{
+private:
+    T mItems[CAPACITY];
+
+    // padded so the consumer's head and producer's tail never share a cache line
+    char mPadding0[64];
+    std::atomic<unsigned int> mHead {0}; // next to pop
+    char mPadding1[64];
+    std::atomic<unsigned int> mTail {0}; // next to push
+
+public:
+    bool push(const T &item)
+    {
+        unsigned int tail = mTail.load(std::memory_order_relaxed);
+        if (tail - mHead.load(std::memory_order_acquire) == CAPACITY) return false;
+
+        mItems[tail % CAPACITY] = item;
+        mTail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T *item)
+    {
+        unsigned int head = mHead.load(std::memory_order_relaxed);
+        if (head == mTail.load(std::memory_order_acquire)) return false;
+
+        *item = mItems[head % CAPACITY];
+        mHead.store(head + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+/**
+ * Triple buffer: one writer publishes whole values, one reader always sees
+ * the latest complete one, and neither ever waits for the other. The writer
+ * fills `back()` and calls `publish()`; the reader calls `front()`, whose
+ * reference stays valid until its next call.
+ */
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr int INDEX = 3;
+    static constexpr int FRESH = 4; // middle holds a value the reader hasn't seen
+
+    T mBuffers[3];
+
+    int mBack  = 0;                  // writer's
+    int mFront = 1;                  // reader's
+    std::atomic<int> mMiddle {2};    // handed between them
+
+public:
+    T &back() { return mBuffers[mBack]; }
+
+    void publish()
+    {
+        mBack = mMiddle.exchange(mBack | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+
+    const T &front()
+    {
+        if (mMiddle.load(std::memory_order_relaxed) & FRESH)
+            mFront = mMiddle.exchange(mFront, std::memory_order_acq_rel) & INDEX;
+
+        return mBuffers[mFront];
+    }
+};
+
+#endif // LOCK_FREE_H
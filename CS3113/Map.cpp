@@ -1,15 +1,59 @@
 #include "Map.h"
+#include "LevelFile.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string.h>
 
+#ifndef CS3113_HEADLESS
 Map::Map(int mapColumns, int mapRows, unsigned int *levelData,
          const char *textureFilePath, float tileSize, int textureColumns,
          int textureRows, Vector2 origin) : 
          mMapColumns {mapColumns}, mMapRows {mapRows}, 
-         mTextureAtlas { LoadTexture(textureFilePath) },
          mLevelData {levelData }, mTileSize {tileSize}, 
          mTextureColumns {textureColumns}, mTextureRows {textureRows},
+         mTextureAtlas { LoadTexture(textureFilePath) },
          mOrigin {origin} { build(); }
+#endif
+
+Map::Map(int mapColumns, int mapRows, unsigned int *levelData,
+         float tileSize, Vector2 origin) : 
+         mMapColumns {mapColumns}, mMapRows {mapRows}, 
+         mLevelData {levelData }, mTileSize {tileSize}, 
+         mTextureColumns {0}, mTextureRows {0},
+#ifndef CS3113_HEADLESS
+         mTextureAtlas {},
+#endif
+         mOrigin {origin} { build(); }
+
+#ifndef CS3113_HEADLESS
+Map::Map(const char *levelFilePath, const char *textureFilePath, 
+         float tileSize, int textureColumns, int textureRows, 
+         Vector2 origin) : 
+         mMapColumns {0}, mMapRows {0}, 
+         mLevelData {nullptr}, mTileSize {tileSize}, 
+         mTextureColumns {textureColumns}, mTextureRows {textureRows},
+         mTextureAtlas { LoadTexture(textureFilePath) },
+         mOrigin {origin} { openStream(levelFilePath); build(); }
+#endif
+
+Map::Map(const char *levelFilePath, float tileSize, Vector2 origin) : 
+         mMapColumns {0}, mMapRows {0}, 
+         mLevelData {nullptr}, mTileSize {tileSize}, 
+         mTextureColumns {0}, mTextureRows {0},
+#ifndef CS3113_HEADLESS
+         mTextureAtlas {},
+#endif
+         mOrigin {origin} { openStream(levelFilePath); build(); }
 
-Map::~Map() { UnloadTexture(mTextureAtlas); }
+Map::~Map() 
+{ 
+#ifndef CS3113_HEADLESS
+    unloadRenderChunks();
+    if (mTextureAtlas.id != 0) UnloadTexture(mTextureAtlas); 
+#endif
+    delete mStream;
+}
 
 void Map::build()
 {
@@ -19,7 +63,13 @@ void Map::build()
     mTopBoundary    = mOrigin.y - (mMapRows * mTileSize) / 2.0f;
     mBottomBoundary = mOrigin.y + (mMapRows * mTileSize) / 2.0f;
 
+    // Streamed maps are too big for whole-map masks; see queryTiles
+    if (mStream == nullptr) buildMasks();
+    if (mHasDistanceFields) setDistanceFields(true);
+
+#ifndef CS3113_HEADLESS
     // Precompute texture areas for each tile
+    mTextureAreas.clear();
     for (int row = 0; row < mTextureRows; row++)
     {
         for (int col = 0; col < mTextureColumns; col++)
@@ -34,25 +84,117 @@ void Map::build()
             mTextureAreas.push_back(textureArea);
         }
     }
+
+    // Render chunks are baked lazily, on first render
+    unloadRenderChunks();
+    mRenderChunkColumns = (mMapColumns + RENDER_CHUNK_TILES - 1) / RENDER_CHUNK_TILES;
+    mRenderChunkRows    = (mMapRows + RENDER_CHUNK_TILES - 1) / RENDER_CHUNK_TILES;
+    mRenderChunks.assign(mRenderChunkColumns * mRenderChunkRows, RenderTexture2D {});
+    mRenderChunkDirty.assign(mRenderChunkColumns * mRenderChunkRows, true);
+#endif
 }
 
+#ifndef CS3113_HEADLESS
+/**
+ * @brief Draws the map as seen through the whole screen.
+ */
 void Map::render()
 {
-    // Draw each tile in the map
-    for (int row = 0; row < mMapRows; row++)
+    render({ 0.0f, 0.0f, (float) GetScreenWidth(), (float) GetScreenHeight() });
+}
+
+/**
+ * @brief Draws the part of the map inside `view` (in world coordinates).
+ * Tiles are baked into one render texture per chunk the first time the chunk
+ * is seen, and re-baked only after `setTile` changes one of its cells, so a
+ * frame costs one draw call per visible chunk rather than one per tile.
+ *
+ * Baking switches render targets, so call this outside `BeginMode2D`.
+ */
+void Map::render(Rectangle view)
+{
+    // Texture-less maps (see the headless constructor) have nothing to draw
+    if (mTextureAtlas.id == 0) return;
+
+    if (mStream != nullptr)
+        streamAround(view.x, view.y, view.x + view.width, view.y + view.height);
+
+    const float chunkSize = RENDER_CHUNK_TILES * mTileSize;
+
+    int firstChunkColumn = std::max(0, (int) floor((view.x - mLeftBoundary) / chunkSize));
+    int lastChunkColumn  = std::min(mRenderChunkColumns - 1,
+        (int) floor((view.x + view.width - mLeftBoundary) / chunkSize));
+    int firstChunkRow    = std::max(0, (int) floor((view.y - mTopBoundary) / chunkSize));
+    int lastChunkRow     = std::min(mRenderChunkRows - 1,
+        (int) floor((view.y + view.height - mTopBoundary) / chunkSize));
+
+    for (int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; chunkRow++)
     {
-        // Draw each column in the row
-        for (int col = 0; col < mMapColumns; col++)
+        for (int chunkColumn = firstChunkColumn; chunkColumn <= lastChunkColumn; chunkColumn++)
+        {
+            int chunk = chunkRow * mRenderChunkColumns + chunkColumn;
+
+            if (mRenderChunkDirty[chunk]) bakeRenderChunk(chunkColumn, chunkRow);
+            if (mRenderChunks[chunk].id == 0) continue; // nothing but empty tiles
+
+            const Texture2D &texture = mRenderChunks[chunk].texture;
+
+            // Render textures are stored upside down, hence the negative height
+            DrawTextureRec(
+                texture,
+                { 0.0f, 0.0f, (float) texture.width, (float) -texture.height },
+                { mLeftBoundary + chunkColumn * chunkSize, 
+                  mTopBoundary  + chunkRow * chunkSize },
+                WHITE
+            );
+        }
+    }
+}
+
+/**
+ * @brief Redraws one chunk's tiles into its render texture, creating the
+ * texture on first use. Chunks with no tiles at all get no texture.
+ */
+void Map::bakeRenderChunk(int chunkColumn, int chunkRow)
+{
+    int chunk = chunkRow * mRenderChunkColumns + chunkColumn;
+    mRenderChunkDirty[chunk] = false;
+
+    int firstColumn = chunkColumn * RENDER_CHUNK_TILES;
+    int firstRow    = chunkRow * RENDER_CHUNK_TILES;
+    int lastColumn  = std::min(firstColumn + RENDER_CHUNK_TILES, mMapColumns) - 1;
+    int lastRow     = std::min(firstRow + RENDER_CHUNK_TILES, mMapRows) - 1;
+
+    if (queryTiles(firstColumn, lastColumn, firstRow, lastRow) == CONTACT_NONE)
+    {
+        if (mRenderChunks[chunk].id != 0) UnloadRenderTexture(mRenderChunks[chunk]);
+        mRenderChunks[chunk] = {};
+        return;
+    }
+
+    if (mRenderChunks[chunk].id == 0)
+    {
+        int size = (int) ceil(RENDER_CHUNK_TILES * mTileSize);
+        mRenderChunks[chunk] = LoadRenderTexture(size, size);
+    }
+
+    BeginTextureMode(mRenderChunks[chunk]);
+    ClearBackground(BLANK);
+
+    // Draw each tile in the chunk
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        for (int col = firstColumn; col <= lastColumn; col++)
         {
             // Get the tile index at the current row and column
-            int tile = mLevelData[row * mMapColumns + col];
+            int tile = getTile(col, row);
 
             // If the tile index is 0, we do not draw anything
             if (tile == 0) continue;
 
             Rectangle destinationArea = {
-                mLeftBoundary + col * mTileSize,
-                mTopBoundary  + row * mTileSize, // y-axis is inverted
+                (col - firstColumn) * mTileSize,
+                (row - firstRow) * mTileSize, // y-axis is inverted
                 mTileSize,
                 mTileSize
             };
@@ -68,9 +210,46 @@ void Map::render()
             );
         }
     }
+
+    EndTextureMode();
+}
+
+void Map::unloadRenderChunks()
+{
+    for (size_t i = 0; i < mRenderChunks.size(); i++)
+        if (mRenderChunks[i].id != 0) UnloadRenderTexture(mRenderChunks[i]);
+
+    mRenderChunks.clear();
+    mRenderChunkDirty.clear();
+}
+
+/**
+ * @brief Drops the render textures of every chunk overlapping an inclusive
+ * tile range, so they are baked again from current tiles when next seen.
+ */
+void Map::invalidateRenderChunks(int firstColumn, int lastColumn, int firstRow,
+    int lastRow)
+{
+    if (mRenderChunkDirty.empty()) return;
+
+    int lastChunkColumn = std::min(lastColumn / RENDER_CHUNK_TILES, mRenderChunkColumns - 1);
+    int lastChunkRow    = std::min(lastRow / RENDER_CHUNK_TILES, mRenderChunkRows - 1);
+
+    for (int chunkRow = firstRow / RENDER_CHUNK_TILES; chunkRow <= lastChunkRow; chunkRow++)
+    {
+        for (int chunkColumn = firstColumn / RENDER_CHUNK_TILES; chunkColumn <= lastChunkColumn; chunkColumn++)
+        {
+            int chunk = chunkRow * mRenderChunkColumns + chunkColumn;
+
+            if (mRenderChunks[chunk].id != 0) UnloadRenderTexture(mRenderChunks[chunk]);
+            mRenderChunks[chunk]     = {};
+            mRenderChunkDirty[chunk] = true;
+        }
+    }
 }
+#endif
 
-int Map::getTileAt(Vector2 position)
+int Map::getTileAt(Vector2 position) const
 {
     if (position.x < mLeftBoundary || position.x > mRightBoundary ||
         position.y < mTopBoundary  || position.y > mBottomBoundary)
@@ -83,6 +262,922 @@ int Map::getTileAt(Vector2 position)
         tileYIndex < 0 || tileYIndex >= mMapRows)
         return false;
 
-    int tile = mLevelData[tileYIndex * mMapColumns + tileXIndex];
+    int tile = getTile(tileXIndex, tileYIndex);
     return tile;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief The tile in a cell, 0 outside the map. On a streamed map, cells in
+ * chunks that are not resident are read straight from the level file: slower
+ * than paging them in, but it changes nothing, so batches and rollouts on
+ * other threads can rely on it.
+ */
+unsigned int Map::getTile(int column, int row) const
+{
+    if (column < 0 || column >= mMapColumns || row < 0 || row >= mMapRows) 
+        return 0;
+
+    if (mStream == nullptr) return mLevelData[row * mMapColumns + column];
+
+    int slot = mChunkSlots[(row / mStreamChunkSize) * mStreamChunkColumns +
+        column / mStreamChunkSize];
+    if (slot < 0) return mStream->getTile(column, row);
+
+    return mSlotTiles[(size_t) slot * mStreamChunkSize * mStreamChunkSize +
+        (row % mStreamChunkSize) * mStreamChunkSize + column % mStreamChunkSize];
+}
+
+/* ----------- STREAMING ----------- */
+
+/**
+ * @brief Opens the level file behind a streamed map. Only its directory is
+ * read; a file that can't be opened leaves an empty 0x0 map.
+ */
+void Map::openStream(const char *levelFilePath)
+{
+    mStream = new LevelStream();
+
+    if (!mStream->open(levelFilePath))
+    {
+        delete mStream;
+        mStream = nullptr;
+        return;
+    }
+
+    mMapColumns         = mStream->getColumns();
+    mMapRows            = mStream->getRows();
+    mStreamChunkSize    = mStream->getChunkSize();
+    mStreamChunkColumns = mStream->getChunkColumns();
+
+    mChunkSlots.assign(mStreamChunkColumns * mStream->getChunkRows(), -1);
+}
+
+/**
+ * @brief Makes sure every chunk overlapping the rectangle (in world 
+ * coordinates) is resident. Chunks are decoded from the mapped file as they
+ * are first needed; once more than MAX_RESIDENT_CHUNKS are resident, the
+ * least recently needed ones are evicted to make room.
+ *
+ * Call it with the lander's surroundings before stepping and with the camera
+ * view before drawing; `Simulation` and `render` do so already. Does nothing
+ * for maps that are not streamed.
+ */
+void Map::streamAround(float left, float top, float right, float bottom)
+{
+    if (mStream == nullptr) return;
+    if (right < mLeftBoundary || left > mRightBoundary ||
+        bottom < mTopBoundary || top > mBottomBoundary)
+        return;
+
+    const float chunkSize = mStreamChunkSize * mTileSize;
+
+    int firstChunkColumn = std::max(0, (int) floor((left - mLeftBoundary) / chunkSize));
+    int lastChunkColumn  = std::min(mStreamChunkColumns - 1,
+        (int) floor((right - mLeftBoundary) / chunkSize));
+    int firstChunkRow    = std::max(0, (int) floor((top - mTopBoundary) / chunkSize));
+    int lastChunkRow     = std::min(mStream->getChunkRows() - 1,
+        (int) floor((bottom - mTopBoundary) / chunkSize));
+
+    mStreamClock++;
+
+    for (int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; chunkRow++)
+    {
+        for (int chunkColumn = firstChunkColumn; chunkColumn <= lastChunkColumn; chunkColumn++)
+        {
+            int chunk = chunkRow * mStreamChunkColumns + chunkColumn;
+            if (mChunkSlots[chunk] < 0) pageIn(chunkColumn, chunkRow);
+
+            mSlotLastUsed[mChunkSlots[chunk]] = mStreamClock;
+        }
+    }
+}
+
+/**
+ * @brief Decodes one chunk into a slot: a free one, the least recently used
+ * one if the map is at its residency limit, or a new one if every resident
+ * chunk is still in use this call.
+ */
+void Map::pageIn(int chunkColumn, int chunkRow)
+{
+    int slot = -1;
+    int resident = getResidentChunks();
+
+    if (resident >= MAX_RESIDENT_CHUNKS)
+    {
+        for (int i = 0; i < (int) mSlotChunks.size(); i++)
+        {
+            if (mSlotChunks[i] < 0 || mSlotPinned[i] ||
+                mSlotLastUsed[i] == mStreamClock) continue;
+
+            if (slot < 0 || mSlotLastUsed[i] < mSlotLastUsed[slot]) slot = i;
+        }
+
+        if (slot >= 0) pageOut(slot);
+    }
+
+    if (slot < 0)
+    {
+        for (int i = 0; i < (int) mSlotChunks.size() && slot < 0; i++)
+            if (mSlotChunks[i] < 0) slot = i;
+    }
+
+    const int chunkTiles = mStreamChunkSize * mStreamChunkSize;
+
+    if (slot < 0)
+    {
+        slot = (int) mSlotChunks.size();
+        mSlotChunks.push_back(-1);
+        mSlotLastUsed.push_back(0);
+        mSlotPinned.push_back(false);
+        mSlotTiles.resize(mSlotTiles.size() + chunkTiles);
+    }
+
+    unsigned char *tiles = &mSlotTiles[(size_t) slot * chunkTiles];
+
+    // A malformed chunk is treated as empty rather than half-decoded
+    if (!mStream->decodeChunk(chunkColumn, chunkRow, tiles))
+        std::fill(tiles, tiles + chunkTiles, 0);
+
+    int chunk = chunkRow * mStreamChunkColumns + chunkColumn;
+    mSlotChunks[slot]   = chunk;
+    mSlotLastUsed[slot] = mStreamClock;
+    mSlotPinned[slot]   = false;
+    mChunkSlots[chunk]  = slot;
+
+#ifndef CS3113_HEADLESS
+    invalidateRenderChunks(chunkColumn * mStreamChunkSize, 
+        (chunkColumn + 1) * mStreamChunkSize - 1, chunkRow * mStreamChunkSize,
+        (chunkRow + 1) * mStreamChunkSize - 1);
+#endif
+}
+
+void Map::pageOut(int slot)
+{
+    int chunk = mSlotChunks[slot];
+    mChunkSlots[chunk] = -1;
+    mSlotChunks[slot]  = -1;
+
+#ifndef CS3113_HEADLESS
+    int chunkColumn = chunk % mStreamChunkColumns;
+    int chunkRow    = chunk / mStreamChunkColumns;
+
+    invalidateRenderChunks(chunkColumn * mStreamChunkSize, 
+        (chunkColumn + 1) * mStreamChunkSize - 1, chunkRow * mStreamChunkSize,
+        (chunkRow + 1) * mStreamChunkSize - 1);
+#endif
+}
+
+int Map::getResidentChunks() const
+{
+    int resident = 0;
+    for (size_t i = 0; i < mSlotChunks.size(); i++)
+        if (mSlotChunks[i] >= 0) resident++;
+
+    return resident;
+}
+
+void Map::buildMasks()
+{
+    mMaskWordsPerRow = (mMapColumns + 63) / 64;
+
+    mSolidMask.assign(mMaskWordsPerRow * mMapRows, 0);
+    mGoalMask.assign(mMaskWordsPerRow * mMapRows, 0);
+    mRockMask.assign(mMaskWordsPerRow * mMapRows, 0);
+
+    for (int row = 0; row < mMapRows; row++)
+        for (int col = 0; col < mMapColumns; col++)
+            updateMasks(col, row);
+}
+
+void Map::updateMasks(int column, int row)
+{
+    unsigned int tile = mLevelData[row * mMapColumns + column];
+
+    int      word = row * mMaskWordsPerRow + column / 64;
+    uint64_t bit  = (uint64_t) 1 << (column % 64);
+
+    mSolidMask[word] = tile != 0         ? mSolidMask[word] | bit : mSolidMask[word] & ~bit;
+    mGoalMask[word]  = tile == GOAL_TILE ? mGoalMask[word]  | bit : mGoalMask[word]  & ~bit;
+    mRockMask[word]  = tile >  GOAL_TILE ? mRockMask[word]  | bit : mRockMask[word]  & ~bit;
+}
+
+/**
+ * @brief Changes one tile, keeping the occupancy masks in step with it.
+ * On a streamed map only resident chunks can be edited, tiles are stored in
+ * 8 bits, and an edited chunk stays resident so the edit is not lost.
+ *
+ * Every edit is journalled, so it can be rolled back with `undoTileEdits`.
+ */
+void Map::setTile(int column, int row, unsigned int tile)
+{
+    unsigned int previous = getTile(column, row);
+
+    if (writeTile(column, row, tile)) 
+        mTileEdits.push_back({ column, row, previous, ++mLastTileEditSerial });
+
+    updateDistanceFields();
+}
+
+/**
+ * @brief Identifies the journal as it was with `count` edits in it: the
+ * newest of those edits' serial, or the last emptying's if there are none.
+ * Undoing edits and making others gives the same count a new serial.
+ */
+uint32_t Map::getTileEditSerial(size_t count) const
+{
+    return count == 0 ? mTileJournalSerial : mTileEdits[count - 1].serial;
+}
+
+/**
+ * @brief Rolls back the newest edits until only `count` remain, the number
+ * `getTileEditCount()` returned at the point to go back to.
+ */
+void Map::undoTileEdits(size_t count)
+{
+    while (mTileEdits.size() > count)
+    {
+        const TileEdit &edit = mTileEdits.back();
+        writeTile(edit.column, edit.row, edit.previous);
+        mTileEdits.pop_back();
+    }
+
+    updateDistanceFields();
+}
+
+/**
+ * @brief Brings the map in line with a new version of its level, e.g. after
+ * the level file was edited, touching only the tiles that differ. Masks,
+ * distance fields and the baked chunks around those tiles are updated the
+ * same way `setTile` updates them; everything else, the landers on the map
+ * included, carries on as it was. The new tiles become the baseline, so the
+ * edit journal is emptied.
+ *
+ * @return how many tiles changed, or -1 if the level's size changed or the
+ * map is streamed, neither of which can be reloaded in place.
+ */
+int Map::reloadTiles(int columns, int rows, const unsigned int *tiles)
+{
+    if (mStream != nullptr || columns != mMapColumns || rows != mMapRows)
+        return -1;
+
+    int changed = 0;
+
+    for (int row = 0; row < rows; row++)
+    {
+        const unsigned int *current = mLevelData + row * columns;
+        const unsigned int *updated = tiles + row * columns;
+
+        if (memcmp(current, updated, columns * sizeof(unsigned int)) == 0) continue;
+
+        for (int column = 0; column < columns; column++)
+            if (current[column] != updated[column])
+            {
+                writeTile(column, row, updated[column]);
+                changed++;
+            }
+    }
+
+    mTileEdits.clear();
+    mTileJournalSerial = ++mLastTileEditSerial;
+    updateDistanceFields();
+
+    return changed;
+}
+
+// setTile without the journal; false if the tile couldn't be written
+bool Map::writeTile(int column, int row, unsigned int tile)
+{
+    if (column < 0 || column >= mMapColumns || row < 0 || row >= mMapRows) 
+        return false;
+
+    if (mStream != nullptr)
+    {
+        int slot = mChunkSlots[(row / mStreamChunkSize) * mStreamChunkColumns +
+            column / mStreamChunkSize];
+        if (slot < 0) return false;
+
+        mSlotTiles[(size_t) slot * mStreamChunkSize * mStreamChunkSize +
+            (row % mStreamChunkSize) * mStreamChunkSize + column % mStreamChunkSize] = 
+            (unsigned char) tile;
+        mSlotPinned[slot] = true;
+    }
+    else
+    {
+        mLevelData[row * mMapColumns + column] = tile;
+        updateMasks(column, row);
+        markDirty(column, row);
+    }
+
+#ifndef CS3113_HEADLESS
+    if (!mRenderChunkDirty.empty())
+        mRenderChunkDirty[(row / RENDER_CHUNK_TILES) * mRenderChunkColumns +
+            column / RENDER_CHUNK_TILES] = true;
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Reports which kinds of tile an axis-aligned rectangle overlaps, as a
+ * combination of `TileContact` flags. Edges are inclusive and snap to tiles
+ * exactly the way `getTileAt` does, so a zero-height rectangle along a
+ * collider's edge sees the same tiles as probing the points on it.
+ *
+ * Costs one or two word operations per overlapped row (one lookup per tile
+ * on streamed maps, which have no masks).
+ */
+unsigned int Map::queryRect(float left, float top, float right,
+    float bottom) const
+{
+    if (right < mLeftBoundary || left > mRightBoundary ||
+        bottom < mTopBoundary || top > mBottomBoundary)
+        return CONTACT_NONE;
+
+    int firstColumn = left < mLeftBoundary ? 0 :
+        (int) floor((left - mLeftBoundary) / mTileSize);
+    int lastColumn  = std::min(mMapColumns - 1, 
+        (int) floor((right - mLeftBoundary) / mTileSize));
+    int firstRow    = top < mTopBoundary ? 0 :
+        (int) floor((top - mTopBoundary) / mTileSize);
+    int lastRow     = std::min(mMapRows - 1, 
+        (int) floor((bottom - mTopBoundary) / mTileSize));
+
+    return queryTiles(firstColumn, lastColumn, firstRow, lastRow);
+}
+
+/**
+ * @brief `queryRect` on tile indices rather than world coordinates. The range
+ * is inclusive and is clipped to the map.
+ */
+unsigned int Map::queryTiles(int firstColumn, int lastColumn, int firstRow,
+    int lastRow) const
+{
+    firstColumn = std::max(firstColumn, 0);
+    firstRow    = std::max(firstRow, 0);
+    lastColumn  = std::min(lastColumn, mMapColumns - 1);
+    lastRow     = std::min(lastRow, mMapRows - 1);
+
+    if (firstColumn > lastColumn || firstRow > lastRow) return CONTACT_NONE;
+
+    if (mStream != nullptr)
+    {
+        unsigned int contact = CONTACT_NONE;
+
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            for (int col = firstColumn; col <= lastColumn; col++)
+            {
+                unsigned int tile = getTile(col, row);
+
+                if (tile != 0)         contact |= CONTACT_SOLID;
+                if (tile == GOAL_TILE) contact |= CONTACT_GOAL;
+                if (tile >  GOAL_TILE) contact |= CONTACT_ROCK;
+            }
+        }
+
+        return contact;
+    }
+
+    uint64_t solid = 0, goal = 0, rock = 0;
+
+    int firstWord = firstColumn / 64;
+    int lastWord  = lastColumn / 64;
+
+    for (int row = firstRow; row <= lastRow; row++)
+    {
+        const int rowStart = row * mMaskWordsPerRow;
+
+        for (int word = firstWord; word <= lastWord; word++)
+        {
+            // bits of this word that fall inside [firstColumn, lastColumn]
+            uint64_t span = ~(uint64_t) 0;
+            if (word == firstWord) span &= ~(uint64_t) 0 << (firstColumn % 64);
+            if (word == lastWord)  span &= ~(uint64_t) 0 >> (63 - lastColumn % 64);
+
+            solid |= mSolidMask[rowStart + word] & span;
+            goal  |= mGoalMask[rowStart + word]  & span;
+            rock  |= mRockMask[rowStart + word]  & span;
+        }
+    }
+
+    unsigned int contact = CONTACT_NONE;
+    if (solid) contact |= CONTACT_SOLID;
+    if (goal)  contact |= CONTACT_GOAL;
+    if (rock)  contact |= CONTACT_ROCK;
+
+    return contact;
+}
+
+/**
+ * @brief Highest tile in an inclusive tile range (clipped to the map), and
+ * where it is. Used to report which tile a sweep ran into.
+ */
+static unsigned int highestTileIn(const Map *map, int firstColumn,
+    int lastColumn, int firstRow, int lastRow, int *column, int *row)
+{
+    unsigned int highest = 0;
+
+    for (int r = std::max(firstRow, 0); r <= std::min(lastRow, map->getMapRows() - 1); r++)
+        for (int c = std::max(firstColumn, 0); c <= std::min(lastColumn, map->getMapColumns() - 1); c++)
+            if (map->getTile(c, r) > highest)
+            {
+                highest = map->getTile(c, r);
+                *column = c;
+                *row    = r;
+            }
+
+    return highest;
+}
+
+/**
+ * @brief Continuous collision for a box moving by `displacement` in one step.
+ * Walks the tile boundaries the box's leading edges cross, in time order
+ * (a DDA over the grid), and stops at the first column or row it enters
+ * that holds a solid tile. Unlike probing the end position, this cannot step
+ * over a one-tile wall however large the displacement is.
+ *
+ * A box that already overlaps a solid tile reports a hit at time 0.
+ *
+ * @param hit if there is a contact, receives the fraction of the step at which
+ * it happens, what was touched, and the highest tile touched and its cell.
+ *
+ * @return whether the box touched a solid tile during the step.
+ */
+bool Map::sweepRect(Vector2 centre, Vector2 halfExtents, Vector2 displacement,
+    SweepHit *hit) const
+{
+    const float L  = mLeftBoundary;
+    const float T  = mTopBoundary;
+    const float ts = mTileSize;
+
+    int firstColumn = (int) floor((centre.x - halfExtents.x - L) / ts);
+    int lastColumn  = (int) floor((centre.x + halfExtents.x - L) / ts);
+    int firstRow    = (int) floor((centre.y - halfExtents.y - T) / ts);
+    int lastRow     = (int) floor((centre.y + halfExtents.y - T) / ts);
+
+    unsigned int contact = queryRect(centre.x - halfExtents.x,
+        centre.y - halfExtents.y, centre.x + halfExtents.x,
+        centre.y + halfExtents.y);
+
+    if (!(contact & CONTACT_SOLID))
+    {
+        if (displacement.x == 0.0f && displacement.y == 0.0f) return false;
+
+        // Leading edges, the column/row each one is in, and when each next
+        // crosses into a new column/row
+        float edgeX = displacement.x > 0.0f ? centre.x + halfExtents.x : centre.x - halfExtents.x;
+        float edgeY = displacement.y > 0.0f ? centre.y + halfExtents.y : centre.y - halfExtents.y;
+        int   stepX = displacement.x > 0.0f ? 1 : -1;
+        int   stepY = displacement.y > 0.0f ? 1 : -1;
+        int   edgeColumn = displacement.x > 0.0f ? lastColumn : firstColumn;
+        int   edgeRow    = displacement.y > 0.0f ? lastRow    : firstRow;
+
+        float nextTimeX = displacement.x == 0.0f ? INFINITY :
+            (L + (edgeColumn + (stepX > 0)) * ts - edgeX) / displacement.x;
+        float nextTimeY = displacement.y == 0.0f ? INFINITY :
+            (T + (edgeRow + (stepY > 0)) * ts - edgeY) / displacement.y;
+
+        float time = 0.0f;
+
+        while (true)
+        {
+            bool alongX = nextTimeX <= nextTimeY;
+            time = alongX ? nextTimeX : nextTimeY;
+            if (time > 1.0f) return false;
+
+            if (alongX)
+            {
+                // Enter the next column, across the rows the box spans then
+                edgeColumn += stepX;
+                float y  = centre.y + displacement.y * time;
+                firstRow = (int) floor((y - halfExtents.y - T) / ts);
+                lastRow  = (int) floor((y + halfExtents.y - T) / ts);
+                firstColumn = lastColumn = edgeColumn;
+                nextTimeX = (L + (edgeColumn + (stepX > 0)) * ts - edgeX) / displacement.x;
+            }
+            else
+            {
+                edgeRow += stepY;
+                float x     = centre.x + displacement.x * time;
+                firstColumn = (int) floor((x - halfExtents.x - L) / ts);
+                lastColumn  = (int) floor((x + halfExtents.x - L) / ts);
+                firstRow = lastRow = edgeRow;
+                nextTimeY = (T + (edgeRow + (stepY > 0)) * ts - edgeY) / displacement.y;
+            }
+
+            contact = queryTiles(firstColumn, lastColumn, firstRow, lastRow);
+            if (contact & CONTACT_SOLID)
+            {
+                hit->time = std::max(time, 0.0f);
+                break;
+            }
+        }
+    }
+    else hit->time = 0.0f;
+
+    hit->contact = contact;
+    hit->column  = -1;
+    hit->row     = -1;
+    hit->tile    = highestTileIn(this, firstColumn, lastColumn, firstRow,
+        lastRow, &hit->column, &hit->row);
+
+    return true;
+}
+
+/* ----------- DISTANCE FIELDS ----------- */
+
+constexpr uint16_t NO_SOLID   = UINT16_MAX;
+constexpr uint32_t NO_PATH    = UINT32_MAX;
+constexpr float    SOLID_UNIT = 64.0f; // mSolidDistance steps per tile
+constexpr float    GOAL_UNIT  = 5.0f;  // mGoalDistance steps per tile
+
+// 8-neighbourhood with chamfer costs: 5 per tile straight, 7 diagonally
+static const int NEIGHBOURS[8][3] = {
+    { -1,  0, 5 }, { 1, 0, 5 }, { 0, -1, 5 }, { 0, 1, 5 },
+    { -1, -1, 7 }, { 1, -1, 7 }, { -1, 1, 7 }, { 1, 1, 7 }
+};
+
+/**
+ * @brief Turns on (or off) the two distance fields: how far each tile's
+ * centre is from the nearest solid tile's centre (an exact Euclidean
+ * distance transform), and how long the shortest path through open tiles is
+ * from there to a landing spot (an open tile on top of a landing pad), going
+ * diagonally only where both tiles beside the diagonal are open.
+ *
+ * They are built here, rebuilt by `build()`, and after `setTile` or
+ * `undoTileEdits` only the parts a change can reach are recomputed. Streamed
+ * maps don't have them.
+ */
+void Map::setDistanceFields(bool enabled)
+{
+    mHasDistanceFields = enabled && mStream == nullptr;
+
+    if (!mHasDistanceFields)
+    {
+        mColumnDistance.clear();
+        mSolidDistance.clear();
+        mGoalDistance.clear();
+        mAffected.clear();
+        return;
+    }
+
+    const size_t cells = (size_t) mMapColumns * mMapRows;
+    mColumnDistance.assign(cells, NO_SOLID);
+    mSolidDistance.assign(cells, NO_SOLID);
+    mGoalDistance.assign(cells, NO_PATH);
+    mAffected.assign(cells, 0);
+    mRowChanged.assign(mMapRows, 0);
+
+    mDirtyLeft   = 0;
+    mDirtyTop    = 0;
+    mDirtyRight  = mMapColumns - 1;
+    mDirtyBottom = mMapRows - 1;
+
+    updateDistanceFields();
+}
+
+void Map::markDirty(int column, int row)
+{
+    if (!mHasDistanceFields) return;
+
+    if (mDirtyLeft > mDirtyRight)
+    {
+        mDirtyLeft = mDirtyRight  = column;
+        mDirtyTop  = mDirtyBottom = row;
+        return;
+    }
+
+    mDirtyLeft   = std::min(mDirtyLeft, column);
+    mDirtyRight  = std::max(mDirtyRight, column);
+    mDirtyTop    = std::min(mDirtyTop, row);
+    mDirtyBottom = std::max(mDirtyBottom, row);
+}
+
+/**
+ * @brief Brings both fields up to date with the tiles edited since the last
+ * update. The distance transform is separable: an edit only changes the
+ * per-column distances in its own column, and then only the rows where one
+ * of those changed need their row pass redone.
+ */
+void Map::updateDistanceFields()
+{
+    if (!mHasDistanceFields || mDirtyLeft > mDirtyRight) return;
+
+    bool changed = false;
+    for (int column = mDirtyLeft; column <= mDirtyRight; column++)
+        changed = updateColumnDistance(column) || changed;
+
+    if (changed)
+    {
+        for (int row = 0; row < mMapRows; row++)
+        {
+            if (mRowChanged[row]) updateSolidDistanceRow(row);
+            mRowChanged[row] = 0;
+        }
+    }
+
+    updateGoalDistance(mDirtyLeft, mDirtyTop, mDirtyRight, mDirtyBottom);
+
+    mDirtyLeft  = mMapColumns; // nothing dirty
+    mDirtyRight = -1;
+}
+
+/**
+ * @brief Recomputes one column's distances (in tiles, up or down) to its
+ * nearest solid tile, flagging the rows whose distance changed.
+ */
+bool Map::updateColumnDistance(int column)
+{
+    std::vector<int> &below = mEnvelopeColumns; // scratch: rows to the last solid above
+    below.resize(std::max(mMapColumns, mMapRows));
+
+    int lastSolid = -1;
+    for (int row = 0; row < mMapRows; row++)
+    {
+        if (mLevelData[row * mMapColumns + column] != 0) lastSolid = row;
+        below[row] = lastSolid < 0 ? INT32_MAX : row - lastSolid;
+    }
+
+    bool changed = false;
+    lastSolid = -1;
+
+    for (int row = mMapRows - 1; row >= 0; row--)
+    {
+        int cell = row * mMapColumns + column;
+        if (mLevelData[cell] != 0) lastSolid = row;
+
+        int nearest = below[row];
+        if (lastSolid >= 0) nearest = std::min(nearest, lastSolid - row);
+
+        uint16_t distance = nearest == INT32_MAX ? NO_SOLID :
+            (uint16_t) std::min(nearest, (int) NO_SOLID - 1);
+
+        if (distance != mColumnDistance[cell])
+        {
+            mColumnDistance[cell] = distance;
+            mRowChanged[row] = 1;
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+/**
+ * @brief Finishes one row of the distance transform from its column
+ * distances (Felzenszwalb & Huttenlocher): the squared distance to tile
+ * `p` is the lower envelope of the parabolas (p - q)² + column(q)².
+ */
+void Map::updateSolidDistanceRow(int row)
+{
+    const uint16_t *columnDistance = &mColumnDistance[row * mMapColumns];
+    uint16_t       *solidDistance  = &mSolidDistance[row * mMapColumns];
+
+    std::vector<int>   &parabolas = mEnvelopeColumns;
+    std::vector<float> &bounds    = mEnvelopeBounds;
+    parabolas.resize(std::max(mMapColumns, mMapRows));
+    bounds.resize(mMapColumns + 1);
+
+    auto height = [&](int q) -> double
+        { return (double) columnDistance[q] * columnDistance[q]; };
+
+    // ––––– LOWER ENVELOPE ––––– //
+    int k = -1;
+    for (int q = 0; q < mMapColumns; q++)
+    {
+        if (columnDistance[q] == NO_SOLID) continue;
+
+        float s = -INFINITY;
+        while (k >= 0)
+        {
+            int v = parabolas[k];
+            s = (float) (((height(q) + (double) q * q) -
+                (height(v) + (double) v * v)) / (2.0 * (q - v)));
+
+            if (s > bounds[k]) break;
+            k--;
+        }
+
+        if (k < 0) s = -INFINITY;
+        k++;
+        parabolas[k]  = q;
+        bounds[k]     = s;
+        bounds[k + 1] = INFINITY;
+    }
+
+    // ––––– SAMPLING ––––– //
+    if (k < 0) // no solid tiles in reach of this row at all
+    {
+        std::fill(solidDistance, solidDistance + mMapColumns, NO_SOLID);
+        return;
+    }
+
+    k = 0;
+    for (int p = 0; p < mMapColumns; p++)
+    {
+        while (bounds[k + 1] < p) k++;
+
+        int    v        = parabolas[k];
+        double distance = std::sqrt((double) (p - v) * (p - v) + height(v));
+
+        solidDistance[p] = (uint16_t) std::min(
+            distance * SOLID_UNIT + 0.5, (double) NO_SOLID - 1);
+    }
+}
+
+bool Map::isLandingSpot(int column, int row) const
+{
+    return row + 1 < mMapRows &&
+        mLevelData[row * mMapColumns + column] == 0 &&
+        mLevelData[(row + 1) * mMapColumns + column] == GOAL_TILE;
+}
+
+/**
+ * @brief Dijkstra over open tiles from every landing spot, redone only where
+ * an edit inside [left, right] × [top, bottom] can matter. Every tile whose
+ * old shortest path may have run through the edit (the dirty rectangle and
+ * its ring, then any neighbour exactly one step further than a tile already
+ * affected) is reset and
+ * re-seeded from its unaffected neighbours; the search then spreads outward,
+ * also lowering tiles beyond that set that newly opened tiles brought closer.
+ */
+void Map::updateGoalDistance(int left, int top, int right, int bottom)
+{
+    left   = std::max(left - 1, 0);
+    top    = std::max(top - 1, 0);
+    right  = std::min(right + 1, mMapColumns - 1);
+    bottom = std::min(bottom + 1, mMapRows - 1);
+
+    auto isOpen = [&](int column, int row)
+    {
+        return column >= 0 && column < mMapColumns && row >= 0 &&
+            row < mMapRows && mLevelData[row * mMapColumns + column] == 0;
+    };
+
+    // can move from (column, row) by this neighbour offset
+    auto canStep = [&](int column, int row, const int *offset)
+    {
+        if (!isOpen(column + offset[0], row + offset[1])) return false;
+        return offset[0] == 0 || offset[1] == 0 ||
+            (isOpen(column + offset[0], row) && isOpen(column, row + offset[1]));
+    };
+
+    // ––––– AFFECTED TILES ––––– //
+    mAffectedCells.clear();
+    for (int row = top; row <= bottom; row++)
+    {
+        for (int column = left; column <= right; column++)
+        {
+            int cell = row * mMapColumns + column;
+            mAffected[cell] = 1;
+            mAffectedCells.push_back(cell);
+        }
+    }
+
+    for (size_t i = 0; i < mAffectedCells.size(); i++)
+    {
+        int      cell     = mAffectedCells[i];
+        uint32_t distance = mGoalDistance[cell];
+        if (distance == NO_PATH) continue;
+
+        int column = cell % mMapColumns, row = cell / mMapColumns;
+        for (const int *offset : NEIGHBOURS)
+        {
+            int c = column + offset[0], r = row + offset[1];
+            if (c < 0 || c >= mMapColumns || r < 0 || r >= mMapRows) continue;
+
+            // only tiles whose shortest path may run through this one
+            int next = r * mMapColumns + c;
+            if (mAffected[next] ||
+                mGoalDistance[next] != distance + (uint32_t) offset[2]) continue;
+
+            mAffected[next] = 1;
+            mAffectedCells.push_back(next);
+        }
+    }
+
+    for (int cell : mAffectedCells) mGoalDistance[cell] = NO_PATH;
+
+    // ––––– SEEDING ––––– //
+    mFrontier.clear();
+    auto push = [&](uint32_t distance, int cell)
+    {
+        mFrontier.push_back((uint64_t) distance << 32 | (uint32_t) cell);
+        std::push_heap(mFrontier.begin(), mFrontier.end(),
+            std::greater<uint64_t>());
+    };
+
+    for (int cell : mAffectedCells)
+    {
+        mAffected[cell] = 0;
+
+        int column = cell % mMapColumns, row = cell / mMapColumns;
+        if (!isOpen(column, row)) continue;
+
+        uint32_t best = isLandingSpot(column, row) ? 0 : NO_PATH;
+        for (const int *offset : NEIGHBOURS)
+        {
+            if (!canStep(column, row, offset)) continue;
+
+            uint32_t distance = mGoalDistance[
+                (row + offset[1]) * mMapColumns + column + offset[0]];
+            if (distance != NO_PATH)
+                best = std::min(best, distance + (uint32_t) offset[2]);
+        }
+
+        if (best != NO_PATH)
+        {
+            mGoalDistance[cell] = best;
+            push(best, cell);
+        }
+    }
+
+    // ––––– DIJKSTRA ––––– //
+    while (!mFrontier.empty())
+    {
+        std::pop_heap(mFrontier.begin(), mFrontier.end(),
+            std::greater<uint64_t>());
+        uint64_t entry = mFrontier.back();
+        mFrontier.pop_back();
+
+        uint32_t distance = (uint32_t) (entry >> 32);
+        int      cell     = (int) (uint32_t) entry;
+        if (distance != mGoalDistance[cell]) continue; // already bettered
+
+        int column = cell % mMapColumns, row = cell / mMapColumns;
+        for (const int *offset : NEIGHBOURS)
+        {
+            if (!canStep(column, row, offset)) continue;
+
+            int      next    = (row + offset[1]) * mMapColumns + column + offset[0];
+            uint32_t through = distance + (uint32_t) offset[2];
+            if (through >= mGoalDistance[next]) continue;
+
+            mGoalDistance[next] = through;
+            push(through, next);
+        }
+    }
+}
+
+/**
+ * @brief Bilinearly samples a per-tile field between tile centres, clamped
+ * to the map's edge. Corners with no value are left out and the rest
+ * reweighted; if all four have none, so does the result.
+ */
+template <typename T>
+static float sampleField(const std::vector<T> &field, T none, int columns,
+    int rows, float column, float row)
+{
+    column = std::min(std::max(column, 0.0f), (float) (columns - 1));
+    row    = std::min(std::max(row,    0.0f), (float) (rows - 1));
+
+    int   c0 = (int) column, r0 = (int) row;
+    int   c1 = std::min(c0 + 1, columns - 1), r1 = std::min(r0 + 1, rows - 1);
+    float fx = column - c0, fy = row - r0;
+
+    const T     corners[4] = { field[r0 * columns + c0], field[r0 * columns + c1],
+                               field[r1 * columns + c0], field[r1 * columns + c1] };
+    const float weights[4] = { (1 - fx) * (1 - fy), fx * (1 - fy),
+                               (1 - fx) * fy,       fx * fy };
+
+    float total = 0.0f, weight = 0.0f;
+    for (int i = 0; i < 4; i++)
+    {
+        if (corners[i] == none) continue;
+        total  += weights[i] * corners[i];
+        weight += weights[i];
+    }
+
+    return weight > 0.0f ? total / weight : INFINITY;
+}
+
+/**
+ * @brief World distance from `position` to the nearest solid tile's edge
+ * (0 inside one), or INFINITY without distance fields or solid tiles.
+ */
+float Map::sampleSolidDistance(Vector2 position) const
+{
+    if (!mHasDistanceFields) return INFINITY;
+
+    float distance = sampleField(mSolidDistance, NO_SOLID, mMapColumns,
+        mMapRows, (position.x - mLeftBoundary) / mTileSize - 0.5f,
+        (position.y - mTopBoundary) / mTileSize - 0.5f);
+
+    return std::max(distance / SOLID_UNIT - 0.5f, 0.0f) * mTileSize;
+}
+
+/**
+ * @brief World length of the shortest path through open tiles from
+ * `position` to a landing spot, or INFINITY without distance fields or
+ * where no landing spot can be reached.
+ */
+float Map::sampleGoalDistance(Vector2 position) const
+{
+    if (!mHasDistanceFields) return INFINITY;
+
+    float distance = sampleField(mGoalDistance, NO_PATH, mMapColumns,
+        mMapRows, (position.x - mLeftBoundary) / mTileSize - 0.5f,
+        (position.y - mTopBoundary) / mTileSize - 0.5f);
+
+    return distance / GOAL_UNIT * mTileSize;
+}
@@ -1,4 +1,29 @@
+#ifndef MAP_H
+#define MAP_H
+
 #include "cs3113.h"
+#include <stdint.h>
+
+// What a collider touches, as returned by Map::queryRect
+enum TileContact
+{
+    CONTACT_NONE  = 0,
+    CONTACT_SOLID = 1 << 0, // any non-zero tile
+    CONTACT_GOAL  = 1 << 1, // the landing pad, tile 2
+    CONTACT_ROCK  = 1 << 2  // tiles above 2, which outrank the landing pad
+};
+
+// First contact found by Map::sweepRect
+struct SweepHit
+{
+    float time;           // fraction of the displacement, in [0, 1]
+    unsigned int contact; // TileContact flags of the tiles entered
+    unsigned int tile;    // highest tile entered
+    int column;           // where that tile is
+    int row;
+};
+
+class LevelStream;
 
 class Map
 {
@@ -7,14 +32,27 @@ private:
     int mMapRows;    // number of rows in map
 
     unsigned int *mLevelData; // array of tile indices
-    Texture2D mTextureAtlas;  // texture atlas
 
     float mTileSize; // size of each tile in pixels
 
     int mTextureColumns; // number of columns in texture atlas
     int mTextureRows;    // number of rows in texture atlas
 
+#ifndef CS3113_HEADLESS
+    Texture2D mTextureAtlas;  // texture atlas
     std::vector<Rectangle> mTextureAreas; // texture areas for each tile
+
+    // Static tiles baked into render textures, RENDER_CHUNK_TILES square
+    int mRenderChunkColumns;
+    int mRenderChunkRows;
+    std::vector<RenderTexture2D> mRenderChunks;  // id 0 = empty or not baked
+    std::vector<unsigned char>   mRenderChunkDirty;
+
+    void bakeRenderChunk(int chunkColumn, int chunkRow);
+    void unloadRenderChunks();
+    void invalidateRenderChunks(int firstColumn, int lastColumn, int firstRow,
+        int lastRow);
+#endif
     Vector2 mOrigin; // center of the map in world coordinates
 
     float mLeftBoundary;  // left boundary of the map in world coordinates
@@ -22,25 +60,136 @@ private:
     float mTopBoundary;   // top boundary of the map in world coordinates
     float mBottomBoundary;// bottom boundary of the map in world coordinates
 
+    // Packed occupancy, one bit per tile and mMaskWordsPerRow words per row
+    int mMaskWordsPerRow;
+    std::vector<uint64_t> mSolidMask;
+    std::vector<uint64_t> mGoalMask;
+    std::vector<uint64_t> mRockMask;
+
+    void buildMasks();
+    void updateMasks(int column, int row);
+
+    // Streamed levels (see LevelFile.h) keep only some chunks resident, each
+    // in a slot of mStreamChunkSize² tiles, least recently used evicted first
+    LevelStream *mStream = nullptr;
+    int mStreamChunkSize    = 0;
+    int mStreamChunkColumns = 0;
+    std::vector<int>           mChunkSlots;  // slot per chunk, -1 = paged out
+    std::vector<int>           mSlotChunks;  // chunk per slot, -1 = free
+    std::vector<unsigned int>  mSlotLastUsed;
+    std::vector<unsigned char> mSlotPinned;  // edited by setTile, kept resident
+    std::vector<unsigned char> mSlotTiles;
+    unsigned int mStreamClock = 0;
+
+    // Every setTile so far, oldest first, for rolling back to a snapshot.
+    // Each edit gets a serial never used before, as does every emptying of
+    // the journal, so a position in it can be told from a rewritten one
+    struct TileEdit
+    {
+        int column;
+        int row;
+        unsigned int previous;
+        uint32_t     serial;
+    };
+    std::vector<TileEdit> mTileEdits;
+    uint32_t mLastTileEditSerial = 0;
+    uint32_t mTileJournalSerial  = 0; // when the journal was last emptied
+
+    bool writeTile(int column, int row, unsigned int tile);
+
+    // Distance fields (see setDistanceFields), one value per tile, and the
+    // tiles edited since they were last brought up to date
+    bool mHasDistanceFields = false;
+    std::vector<uint16_t> mColumnDistance; // tiles to the nearest solid tile in the column
+    std::vector<uint16_t> mSolidDistance;  // to the nearest solid tile's centre, 1/64 tiles
+    std::vector<uint32_t> mGoalDistance;   // path length to a pad, 1/5 tiles
+    int mDirtyLeft, mDirtyTop, mDirtyRight, mDirtyBottom;
+
+    // scratch for the updates, kept to avoid reallocating
+    std::vector<int>           mEnvelopeColumns;
+    std::vector<float>         mEnvelopeBounds;
+    std::vector<unsigned char> mRowChanged;
+    std::vector<unsigned char> mAffected;
+    std::vector<int>           mAffectedCells;
+    std::vector<uint64_t>      mFrontier; // min-heap of (distance << 32 | cell)
+
+    void markDirty(int column, int row);
+    void updateDistanceFields();
+    bool updateColumnDistance(int column);
+    void updateSolidDistanceRow(int row);
+    void updateGoalDistance(int left, int top, int right, int bottom);
+    bool isLandingSpot(int column, int row) const;
+
+    void openStream(const char *levelFilePath);
+    void pageIn(int chunkColumn, int chunkRow);
+    void pageOut(int slot);
+
 public:
+#ifndef CS3113_HEADLESS
     Map(int mapColumns, int mapRows, unsigned int *levelData,
         const char *textureFilePath, float tileSize, int textureColumns,
         int textureRows, Vector2 origin);
+#endif
+    // Texture-less map, used by the headless simulation core
+    Map(int mapColumns, int mapRows, unsigned int *levelData,
+        float tileSize, Vector2 origin);
+#ifndef CS3113_HEADLESS
+    Map(const char *levelFilePath, const char *textureFilePath, float tileSize,
+        int textureColumns, int textureRows, Vector2 origin);
+#endif
+    // Streamed from a level file; chunks are paged in by streamAround
+    Map(const char *levelFilePath, float tileSize, Vector2 origin);
     ~Map();
 
+    Map(const Map &) = delete;
+    Map &operator=(const Map &) = delete;
+
     void build();
+#ifndef CS3113_HEADLESS
     void render();
-    int getTileAt(Vector2 position);
+    void render(Rectangle view);
+#endif
+    int getTileAt(Vector2 position) const;
+    unsigned int getTile(int column, int row) const;
+    void streamAround(float left, float top, float right, float bottom);
+    unsigned int queryRect(float left, float top, float right,
+        float bottom) const;
+    unsigned int queryTiles(int firstColumn, int lastColumn, int firstRow,
+        int lastRow) const;
+    bool sweepRect(Vector2 centre, Vector2 halfExtents, Vector2 displacement,
+        SweepHit *hit) const;
+    void setTile(int column, int row, unsigned int tile);
+    void undoTileEdits(size_t count);
+    int  reloadTiles(int columns, int rows, const unsigned int *tiles);
+
+    void  setDistanceFields(bool enabled);
+    float sampleSolidDistance(Vector2 position) const;
+    float sampleGoalDistance(Vector2 position) const;
 
     int           getMapColumns()     const { return mMapColumns;     };
     int           getMapRows()        const { return mMapRows;        };
     float         getTileSize()       const { return mTileSize;       };
     unsigned int* getLevelData()      const { return mLevelData;      };
-    Texture2D     getTextureAtlas()   const { return mTextureAtlas;   };
     int           getTextureColumns() const { return mTextureColumns; };
     int           getTextureRows()    const { return mTextureRows;    };
     float         getLeftBoundary()   const { return mLeftBoundary;   };
     float         getRightBoundary()  const { return mRightBoundary;  };
     float         getTopBoundary()    const { return mTopBoundary;    };
     float         getBottomBoundary() const { return mBottomBoundary; };
-};
\ No newline at end of file
+    Vector2       getOrigin()         const { return mOrigin;         };
+    bool          isStreamed()        const { return mStream != nullptr; };
+    int           getResidentChunks() const;
+    size_t        getTileEditCount()  const { return mTileEdits.size(); };
+    uint32_t      getTileEditSerial(size_t count) const;
+    bool          hasDistanceFields() const { return mHasDistanceFields; };
+
+    static constexpr unsigned int GOAL_TILE = 2;
+    static constexpr int RENDER_CHUNK_TILES = 16;
+    static constexpr int MAX_RESIDENT_CHUNKS = 64;
+
+#ifndef CS3113_HEADLESS
+    Texture2D     getTextureAtlas()   const { return mTextureAtlas;   };
+#endif
+};
+
+#endif // MAP_H
@@ -0,0 +1,151 @@
+#include "ParticleSystem.h"
+#include "Random.h"
+
+#ifndef CS3113_HEADLESS
+// start colour of each kind; particles fade out over their lifetime
+static const Color PARTICLE_COLOURS[PARTICLE_KIND_COUNT] = {
+    { 255, 170,  60, 255 }, // exhaust
+    { 200, 200, 210, 255 }  // debris
+};
+#endif
+
+ParticleSystem::ParticleSystem(int capacity, uint64_t seed) :
+    mCapacity {capacity}, mPositionX(capacity), mPositionY(capacity),
+    mVelocityX(capacity), mVelocityY(capacity), mAge(capacity),
+    mLifetime(capacity), mSize(capacity), mKind(capacity), mRandom {seed} { }
+
+// uniform in [low, high)
+float ParticleSystem::random(float low, float high)
+{
+    return low + (high - low) * nextUniform(&mRandom);
+}
+
+void ParticleSystem::emit(ParticleKind kind, Vector2 position,
+    Vector2 velocity, float lifetime, float size)
+{
+    if (mCount == mCapacity) return;
+
+    int i = mCount++;
+    mPositionX[i] = position.x;
+    mPositionY[i] = position.y;
+    mVelocityX[i] = velocity.x;
+    mVelocityY[i] = velocity.y;
+    mAge[i]       = 0.0f;
+    mLifetime[i]  = lifetime;
+    mSize[i]      = size;
+    mKind[i]      = (unsigned char) kind;
+}
+
+/**
+ * @brief Emits a frame's worth of exhaust from a lander thrusting at `angle`
+ * (in degrees, clockwise from "up") from `position`, out the opposite way
+ * to the thrust and carried along at the lander's `velocity`.
+ */
+void ParticleSystem::emitExhaust(Vector2 position, float angle,
+    Vector2 velocity, float deltaTime)
+{
+    mExhaustDebt += EXHAUST_RATE * deltaTime;
+    int count = (int) mExhaustDebt;
+    mExhaustDebt -= count;
+
+    for (int i = 0; i < count; i++)
+    {
+        float direction = (angle + random(-15.0f, 15.0f)) * PI / 180.0f;
+        float speed     = random(90.0f, 180.0f);
+
+        // spread along the frame's travel, so a fast lander leaves no gaps
+        float back = random(0.0f, deltaTime);
+        Vector2 origin = { position.x - velocity.x * back,
+                           position.y - velocity.y * back };
+
+        emit(PARTICLE_EXHAUST, origin,
+            { velocity.x - sinf(direction) * speed,
+              velocity.y + cosf(direction) * speed },
+            random(0.3f, 0.7f), random(2.0f, 4.0f));
+    }
+}
+
+/**
+ * @brief A crash: debris flung out in every direction from `position`.
+ */
+void ParticleSystem::emitDebris(Vector2 position, Vector2 velocity)
+{
+    for (int i = 0; i < DEBRIS_COUNT; i++)
+    {
+        float direction = random(0.0f, 2.0f * PI);
+        float speed     = random(20.0f, 260.0f);
+
+        emit(PARTICLE_DEBRIS, position,
+            { velocity.x + cosf(direction) * speed,
+              velocity.y + sinf(direction) * speed },
+            random(0.8f, 2.5f), random(1.5f, 3.5f));
+    }
+}
+
+void ParticleSystem::update(float deltaTime)
+{
+    const int   count = mCount;
+    const float drag  = powf(DRAG, deltaTime * 60.0f);
+    const float fall  = GRAVITY * deltaTime;
+
+    float *positionX = mPositionX.data(), *positionY = mPositionY.data();
+    float *velocityX = mVelocityX.data(), *velocityY = mVelocityY.data();
+    float *age       = mAge.data();
+
+    // ––––– INTEGRATION ––––– //
+    // one array per loop and no branches, so each vectorises
+    for (int i = 0; i < count; i++) velocityX[i] *= drag;
+    for (int i = 0; i < count; i++) velocityY[i] = velocityY[i] * drag + fall;
+    for (int i = 0; i < count; i++) positionX[i] += velocityX[i] * deltaTime;
+    for (int i = 0; i < count; i++) positionY[i] += velocityY[i] * deltaTime;
+    for (int i = 0; i < count; i++) age[i] += deltaTime;
+
+    // ––––– EXPIRY ––––– //
+    for (int i = 0; i < mCount; )
+    {
+        if (mAge[i] < mLifetime[i]) { i++; continue; }
+
+        int last = --mCount;
+        mPositionX[i] = mPositionX[last];
+        mPositionY[i] = mPositionY[last];
+        mVelocityX[i] = mVelocityX[last];
+        mVelocityY[i] = mVelocityY[last];
+        mAge[i]       = mAge[last];
+        mLifetime[i]  = mLifetime[last];
+        mSize[i]      = mSize[last];
+        mKind[i]      = mKind[last];
+    }
+}
+
+#ifndef CS3113_HEADLESS
+/**
+ * @brief Draws every live particle as a quad fading out with age, in one
+ * batch (rlgl only splits it if it outgrows its vertex buffer).
+ */
+void ParticleSystem::render() const
+{
+    if (mCount == 0) return;
+
+    rlCheckRenderBatchLimit(mCount * 4);
+    rlSetTexture(rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+
+    for (int i = 0; i < mCount; i++)
+    {
+        const Color &colour = PARTICLE_COLOURS[mKind[i]];
+        float half = mSize[i] / 2.0f;
+        float left = mPositionX[i] - half, right  = mPositionX[i] + half;
+        float top  = mPositionY[i] - half, bottom = mPositionY[i] + half;
+
+        rlColor4ub(colour.r, colour.g, colour.b,
+            (unsigned char) (colour.a * (1.0f - mAge[i] / mLifetime[i])));
+        rlVertex2f(left,  top);
+        rlVertex2f(left,  bottom);
+        rlVertex2f(right, bottom);
+        rlVertex2f(right, top);
+    }
+
+    rlEnd();
+    rlSetTexture(0);
+}
+#endif
@@ -0,0 +1,65 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "cs3113.h"
+#include <stdint.h>
+
+enum ParticleKind { PARTICLE_EXHAUST, PARTICLE_DEBRIS, PARTICLE_KIND_COUNT };
+
+/**
+ * Fixed-capacity pool of short-lived particles: thrust exhaust and crash
+ * debris. Every particle attribute lives in its own array, all allocated up
+ * front, so emitting never allocates and `update` is a handful of straight
+ * loops over floats that the compiler can vectorise. Dead particles are
+ * swapped with the last live one, keeping the live ones packed at the front.
+ * When the pool is full new particles are dropped.
+ *
+ * Particles are cosmetic: they are advanced once per rendered frame, never
+ * inside a fixed step, and nothing in the simulation reads them. `render`
+ * draws them all as untextured quads in a single batch.
+ */
+class ParticleSystem
+{
+public:
+    static constexpr float EXHAUST_RATE  = 900.0f; // particles per second of thrust
+    static constexpr int   DEBRIS_COUNT  = 2500;   // particles per crash
+    static constexpr float GRAVITY       = 60.0f;  // in pixels per second²
+    static constexpr float DRAG          = 0.98f;  // velocity kept per 1/60 s
+
+private:
+    int mCapacity;
+    int mCount = 0;
+
+    std::vector<float> mPositionX;
+    std::vector<float> mPositionY;
+    std::vector<float> mVelocityX;
+    std::vector<float> mVelocityY;
+    std::vector<float> mAge;      // in seconds
+    std::vector<float> mLifetime;
+    std::vector<float> mSize;     // side of the quad, in pixels
+    std::vector<unsigned char> mKind;
+
+    float    mExhaustDebt = 0.0f; // fraction of a particle owed from last frame
+    uint64_t mRandom;
+
+    float random(float low, float high);
+    void  emit(ParticleKind kind, Vector2 position, Vector2 velocity,
+        float lifetime, float size);
+
+public:
+    ParticleSystem(int capacity, uint64_t seed = 1);
+
+    void emitExhaust(Vector2 position, float angle, Vector2 velocity,
+        float deltaTime);
+    void emitDebris(Vector2 position, Vector2 velocity);
+    void update(float deltaTime);
+    void clear() { mCount = 0; mExhaustDebt = 0.0f; }
+#ifndef CS3113_HEADLESS
+    void render() const;
+#endif
+
+    int getCount()    const { return mCount;    }
+    int getCapacity() const { return mCapacity; }
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -0,0 +1,288 @@
+#include "Physics.h"
+#include "Profiler.h"
+#include <algorithm>
+
+/**
+ * @brief Axis-aligned bounding box test between two centred colliders.
+ */
+bool isOverlapping(Vector2 positionA, Vector2 dimensionsA,
+    Vector2 positionB, Vector2 dimensionsB)
+{
+    float xDistance = fabs(positionA.x - positionB.x) -
+        ((dimensionsA.x + dimensionsB.x) / 2.0f);
+    float yDistance = fabs(positionA.y - positionB.y) -
+        ((dimensionsA.y + dimensionsB.y) / 2.0f);
+
+    if (xDistance < 0.0f && yDistance < 0.0f) return true;
+
+    return false;
+}
+
+/**
+ * @brief Resolves the tile a lander touches, if any, into a win or a loss.
+ * Touching the landing pad (tile 2) wins; touching any other tile loses.
+ */
+static CollisionStatus resolveTile(int highestCollidingTile,
+    CollisionStatus status)
+{
+    if (highestCollidingTile == 0) return status;
+
+    return highestCollidingTile == 2 ? WIN : LOSS;
+}
+
+/**
+ * @brief Same ranking as `resolveTile` applied to the highest tile touched,
+ * but from `Map::queryRect`'s contact flags.
+ */
+CollisionStatus resolveContact(unsigned int contact, CollisionStatus status)
+{
+    if (contact & CONTACT_ROCK)  return LOSS;
+    if (contact & CONTACT_GOAL)  return WIN;
+    if (contact & CONTACT_SOLID) return LOSS;
+
+    return status;
+}
+
+/**
+ * While the collider is at most two tiles across, its three probes per edge
+ * see every tile along that edge, so one `queryRect` on the edge gives the
+ * same answer as the probes. Bigger colliders keep the original probes.
+ */
+static bool edgesMatchProbes(const Map *map, float halfWidth, float halfHeight)
+{
+    return halfWidth <= map->getTileSize() && halfHeight <= map->getTileSize();
+}
+
+CollisionStatus checkMapCollisionY(const Map *map, Vector2 position,
+    Vector2 colliderDimensions, float velocityY, CollisionStatus status)
+{
+    if (map == nullptr) return status;
+
+    PROFILE_SCOPE(ZONE_COLLISION);
+
+    float halfWidth  = colliderDimensions.x / 2.0f;
+    float halfHeight = colliderDimensions.y / 2.0f;
+
+    if (edgesMatchProbes(map, halfWidth, halfHeight))
+    {
+        float top    = position.y - halfHeight;
+        float bottom = position.y + halfHeight;
+
+        if (velocityY < 0.0f) status = resolveContact(map->queryRect(
+            position.x - halfWidth, top, position.x + halfWidth, top), status);
+        if (velocityY > 0.0f) status = resolveContact(map->queryRect(
+            position.x - halfWidth, bottom, position.x + halfWidth, bottom), status);
+
+        return status;
+    }
+
+    Vector2 topCentreProbe    = { position.x, position.y - halfHeight };
+    Vector2 topLeftProbe      = { position.x - halfWidth, position.y - halfHeight };
+    Vector2 topRightProbe     = { position.x + halfWidth, position.y - halfHeight };
+
+    Vector2 bottomCentreProbe = { position.x, position.y + halfHeight };
+    Vector2 bottomLeftProbe   = { position.x - halfWidth, position.y + halfHeight };
+    Vector2 bottomRightProbe  = { position.x + halfWidth, position.y + halfHeight };
+
+    // COLLISION ABOVE (moving upward)
+    int highest_colliding_tile = std::max({
+        map->getTileAt(topCentreProbe),
+        map->getTileAt(topLeftProbe),
+        map->getTileAt(topRightProbe)
+    });
+
+    if (velocityY < 0.0f) status = resolveTile(highest_colliding_tile, status);
+
+    // COLLISION BELOW (moving downward)
+    highest_colliding_tile = std::max({
+        map->getTileAt(bottomCentreProbe),
+        map->getTileAt(bottomLeftProbe),
+        map->getTileAt(bottomRightProbe)
+    });
+
+    if (velocityY > 0.0f) status = resolveTile(highest_colliding_tile, status);
+
+    return status;
+}
+
+CollisionStatus checkMapCollisionX(const Map *map, Vector2 position,
+    Vector2 colliderDimensions, float velocityY, CollisionStatus status)
+{
+    if (map == nullptr) return status;
+
+    PROFILE_SCOPE(ZONE_COLLISION);
+
+    float halfWidth  = colliderDimensions.x / 2.0f;
+    float halfHeight = colliderDimensions.y / 2.0f;
+
+    // The side edges are gated on the vertical velocity, exactly like the
+    // original Entity code, so that outcomes do not change.
+    if (edgesMatchProbes(map, halfWidth, halfHeight))
+    {
+        float left  = position.x - halfWidth;
+        float right = position.x + halfWidth;
+
+        if (velocityY < 0.0f) status = resolveContact(map->queryRect(
+            left, position.y - halfHeight, left, position.y + halfHeight), status);
+        if (velocityY > 0.0f) status = resolveContact(map->queryRect(
+            right, position.y - halfHeight, right, position.y + halfHeight), status);
+
+        return status;
+    }
+
+    Vector2 leftCentreProbe   = { position.x - halfWidth, position.y };
+    Vector2 leftTopProbe      = { position.x - halfWidth, position.y - halfHeight };
+    Vector2 leftBottomProbe   = { position.x - halfWidth, position.y + halfHeight };
+
+    Vector2 rightCentreProbe  = { position.x + halfWidth, position.y };
+    Vector2 rightTopProbe     = { position.x + halfWidth, position.y - halfHeight };
+    Vector2 rightBottomProbe  = { position.x + halfWidth, position.y + halfHeight };
+
+    int highest_colliding_tile = std::max({
+        map->getTileAt(leftCentreProbe),
+        map->getTileAt(leftTopProbe),
+        map->getTileAt(leftBottomProbe)
+    });
+
+    if (velocityY < 0.0f) status = resolveTile(highest_colliding_tile, status);
+
+    highest_colliding_tile = std::max({
+        map->getTileAt(rightCentreProbe),
+        map->getTileAt(rightTopProbe),
+        map->getTileAt(rightBottomProbe)
+    });
+
+    if (velocityY > 0.0f) status = resolveTile(highest_colliding_tile, status);
+
+    return status;
+}
+
+/**
+ * @brief Action 0 to LANDER_ACTION_COUNT - 1 as input: rotation (left, none,
+ * right) is the action mod 3, and actions 3 and up thrust.
+ */
+LanderInput landerAction(int action)
+{
+    return { action % 3 - 1, action >= 3 };
+}
+
+/**
+ * @brief Does what `processInput()` does to the player entity: clears last
+ * step's input, resets acceleration to gravity and applies the new input.
+ */
+void applyLanderInput(LanderState *lander, LanderInput input, float gravity)
+{
+    lander->rotation     = input.rotate * LANDER_ROTATION_SPEED;
+    lander->boosting     = input.boost;
+    lander->acceleration = { 0.0f, gravity };
+}
+
+// The part of a step before the lander moves: rotate, boost, apply drag
+static void integrateLander(LanderState *lander, float deltaTime)
+{
+    lander->angle += lander->rotation * deltaTime;
+
+    // ––––– BOOSTING ––––– //
+    if (lander->boosting && lander->fuel > 0)
+    {
+        float angleInRadians = lander->angle * PI / 180;
+        lander->acceleration = {
+            sin(angleInRadians) * LANDER_BOOST_SPEED,
+            -cos(angleInRadians) * LANDER_BOOST_SPEED
+        };
+        lander->fuel -= deltaTime;
+    }
+
+    lander->velocity.x += lander->acceleration.x * deltaTime;
+    lander->velocity.y += lander->acceleration.y * deltaTime;
+    lander->velocity.x *= LANDER_DRAG;
+    lander->velocity.y *= LANDER_DRAG;
+}
+
+/**
+ * @brief Advances one lander by one step. This is the same sequence as
+ * `Entity::update`: rotate, boost, integrate velocity with drag, then move and
+ * collide along Y before X.
+ *
+ * @param obstaclePositions centres of any other colliders (e.g. the UFO),
+ * touching one of them is a loss.
+ */
+void stepLander(LanderState *lander, float deltaTime, const Map *map,
+    const Vector2 *obstaclePositions, const Vector2 *obstacleDimensions,
+    int obstacleCount)
+{
+    integrateLander(lander, deltaTime);
+
+    lander->position.y += lander->velocity.y * deltaTime;
+    for (int i = 0; i < obstacleCount; i++)
+        if (isOverlapping(lander->position, lander->colliderDimensions,
+                obstaclePositions[i], obstacleDimensions[i]))
+            lander->collisionStatus = LOSS;
+    lander->collisionStatus = checkMapCollisionY(map, lander->position,
+        lander->colliderDimensions, lander->velocity.y, lander->collisionStatus);
+
+    lander->position.x += lander->velocity.x * deltaTime;
+    for (int i = 0; i < obstacleCount; i++)
+        if (isOverlapping(lander->position, lander->colliderDimensions,
+                obstaclePositions[i], obstacleDimensions[i]))
+            lander->collisionStatus = LOSS;
+    lander->collisionStatus = checkMapCollisionX(map, lander->position,
+        lander->colliderDimensions, lander->velocity.y, lander->collisionStatus);
+}
+
+/**
+ * @brief Moves a collider by `displacement`, stopping it at the first solid
+ * tile it runs into on the way (see `Map::sweepRect`). Touching the landing
+ * pad wins and anything else loses, ranked as in `checkMapCollisionY/X`.
+ */
+CollisionStatus sweepMapCollision(const Map *map, Vector2 *position,
+    Vector2 colliderDimensions, Vector2 displacement, CollisionStatus status)
+{
+    PROFILE_SCOPE(ZONE_COLLISION);
+    SweepHit hit;
+
+    if (map == nullptr || !map->sweepRect(*position,
+            { colliderDimensions.x / 2.0f, colliderDimensions.y / 2.0f },
+            displacement, &hit))
+    {
+        position->x += displacement.x;
+        position->y += displacement.y;
+        return status;
+    }
+
+    position->x += displacement.x * hit.time;
+    position->y += displacement.y * hit.time;
+
+    return resolveContact(hit.contact, status);
+}
+
+/**
+ * @brief `stepLander` with continuous collision against the map: the Y and X
+ * moves are swept rather than probed at their end points, so a lander cannot
+ * tunnel through thin walls at large timesteps. The lander stops where it
+ * first touches a tile, and the X move is skipped if the Y move already hit.
+ */
+void stepLanderContinuous(LanderState *lander, float deltaTime,
+    const Map *map, const Vector2 *obstaclePositions,
+    const Vector2 *obstacleDimensions, int obstacleCount)
+{
+    integrateLander(lander, deltaTime);
+
+    lander->collisionStatus = sweepMapCollision(map, &lander->position,
+        lander->colliderDimensions, { 0.0f, lander->velocity.y * deltaTime },
+        lander->collisionStatus);
+    for (int i = 0; i < obstacleCount; i++)
+        if (isOverlapping(lander->position, lander->colliderDimensions,
+                obstaclePositions[i], obstacleDimensions[i]))
+            lander->collisionStatus = LOSS;
+
+    if (lander->collisionStatus != PLAYING) return;
+
+    lander->collisionStatus = sweepMapCollision(map, &lander->position,
+        lander->colliderDimensions, { lander->velocity.x * deltaTime, 0.0f },
+        lander->collisionStatus);
+    for (int i = 0; i < obstacleCount; i++)
+        if (isOverlapping(lander->position, lander->colliderDimensions,
+                obstaclePositions[i], obstacleDimensions[i]))
+            lander->collisionStatus = LOSS;
+}
@@ -0,0 +1,68 @@
+#ifndef PHYSICS_H
+#define PHYSICS_H
+
+#include "Map.h"
+
+enum CollisionStatus   { PLAYING, LOSS, WIN };
+enum RotateDirection   { ROTATE_LEFT = -1, ROTATE_RIGHT = 1 };
+
+/**
+ * Everything the lander physics needs, with none of the texture or animation
+ * state that `Entity` carries. Plain data, so it can be copied freely.
+ */
+struct LanderState
+{
+    Vector2 position;
+    Vector2 velocity;
+    Vector2 acceleration;
+    Vector2 colliderDimensions;
+
+    float angle;    // in degrees, clockwise from "up"
+    float rotation; // in degrees per second
+    float fuel;     // in seconds of thrust
+
+    bool boosting;
+    CollisionStatus collisionStatus;
+};
+
+/**
+ * One fixed step's worth of player input, i.e. what `processInput()` reads off
+ * the keyboard: rotation direction (-1, 0 or 1) and whether thrust is held.
+ */
+struct LanderInput
+{
+    int  rotate;
+    bool boost;
+};
+
+// Inputs as a small discrete set, for planners and trained controllers
+constexpr int LANDER_ACTION_COUNT = 6;
+
+LanderInput landerAction(int action);
+
+constexpr float LANDER_ROTATION_SPEED = 30.0f;
+constexpr float LANDER_BOOST_SPEED    = 30.0f;
+constexpr float LANDER_DRAG           = 0.995f;
+constexpr float LANDER_STARTING_FUEL  = 20.0f;
+
+bool isOverlapping(Vector2 positionA, Vector2 dimensionsA,
+    Vector2 positionB, Vector2 dimensionsB);
+CollisionStatus resolveContact(unsigned int contact, CollisionStatus status);
+
+CollisionStatus checkMapCollisionY(const Map *map, Vector2 position,
+    Vector2 colliderDimensions, float velocityY, CollisionStatus status);
+CollisionStatus checkMapCollisionX(const Map *map, Vector2 position,
+    Vector2 colliderDimensions, float velocityY, CollisionStatus status);
+
+void applyLanderInput(LanderState *lander, LanderInput input, float gravity);
+void stepLander(LanderState *lander, float deltaTime, const Map *map,
+    const Vector2 *obstaclePositions, const Vector2 *obstacleDimensions,
+    int obstacleCount);
+
+CollisionStatus sweepMapCollision(const Map *map, Vector2 *position,
+    Vector2 colliderDimensions, Vector2 displacement, CollisionStatus status);
+void stepLanderContinuous(LanderState *lander, float deltaTime,
+    const Map *map, const Vector2 *obstaclePositions,
+    const Vector2 *obstacleDimensions, int obstacleCount);
+
+#endif // PHYSICS_H
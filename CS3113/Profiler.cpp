@@ -0,0 +1,234 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+static const char *ZONE_NAMES[ZONE_COUNT] = {
+    "frame", "input", "update", "fixed step", "collision", "map render",
+    "entity render", "autopilot", "particles"
+};
+
+/**
+ * One ring-buffer slot, guarded by a sequence number (a seqlock): odd while
+ * its writer is filling it, 2 * (sample index + 1) once complete. Readers
+ * keep a slot only if the sequence is the one they expect before and after
+ * copying it, so torn or overwritten samples are skipped, never read.
+ */
+struct ProfileSlot
+{
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> start;
+    std::atomic<uint64_t> duration;
+    std::atomic<uint32_t> zone;
+    std::atomic<uint32_t> thread;
+};
+
+static ProfileSlot           gSlots[PROFILE_CAPACITY];
+static std::atomic<uint64_t> gHead {0};
+static std::atomic<bool>     gEnabled {false};
+static std::atomic<uint32_t> gThreadCount {0};
+
+static const std::chrono::steady_clock::time_point gEpoch =
+    std::chrono::steady_clock::now();
+
+// Frame history for the overlay, touched by the main thread only
+static float    gFrameTimes[PROFILE_FRAME_HISTORY];
+static int      gFrameSteps[PROFILE_FRAME_HISTORY];
+static int      gFrameCount = 0;
+static uint64_t gLastFrameMark = 0;
+
+const char *profileZoneName(ProfileZone zone) { return ZONE_NAMES[zone]; }
+
+void setProfilerEnabled(bool enabled) { gEnabled.store(enabled, std::memory_order_relaxed); }
+bool isProfilerEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+/**
+ * @brief Nanoseconds since the profiler's epoch, plus one so that a real
+ * timestamp is never 0.
+ */
+uint64_t profilerNow()
+{
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - gEpoch).count() + 1;
+}
+
+static uint32_t currentThread()
+{
+    static thread_local uint32_t thread = gThreadCount.fetch_add(1) + 1;
+    return thread;
+}
+
+void recordProfileSample(ProfileZone zone, uint64_t start, uint64_t end)
+{
+    uint64_t index = gHead.fetch_add(1, std::memory_order_relaxed);
+    ProfileSlot &slot = gSlots[index & (PROFILE_CAPACITY - 1)];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.duration.store(end - start, std::memory_order_relaxed);
+    slot.zone.store(zone, std::memory_order_relaxed);
+    slot.thread.store(currentThread(), std::memory_order_relaxed);
+
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Copies out every complete sample still in the ring, oldest first.
+ * Safe to call while other threads are recording.
+ */
+void snapshotProfileSamples(std::vector<ProfileSample> *samples)
+{
+    samples->clear();
+
+    uint64_t head  = gHead.load(std::memory_order_acquire);
+    uint64_t first = head > (uint64_t) PROFILE_CAPACITY ? head - PROFILE_CAPACITY : 0;
+    samples->reserve(head - first);
+
+    for (uint64_t index = first; index < head; index++)
+    {
+        const ProfileSlot &slot = gSlots[index & (PROFILE_CAPACITY - 1)];
+
+        uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2) continue;
+
+        ProfileSample sample;
+        sample.start    = slot.start.load(std::memory_order_relaxed);
+        sample.duration = slot.duration.load(std::memory_order_relaxed);
+        sample.zone     = (ProfileZone) slot.zone.load(std::memory_order_relaxed);
+        sample.thread   = slot.thread.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        samples->push_back(sample);
+    }
+}
+
+/**
+ * @brief Ends a frame for the overlay's graph: how long it was since the last
+ * mark, and how many fixed steps the `update()` accumulator ran in it.
+ */
+void markProfilerFrame(int fixedSteps)
+{
+    uint64_t now = profilerNow();
+
+    if (gLastFrameMark != 0)
+    {
+        int frame = gFrameCount++ % PROFILE_FRAME_HISTORY;
+        gFrameTimes[frame] = (now - gLastFrameMark) / 1e6f;
+        gFrameSteps[frame] = fixedSteps;
+    }
+
+    gLastFrameMark = now;
+}
+
+/**
+ * @brief Writes the samples in the ring as Chrome trace events, one complete
+ * ("X") event per sample, timestamps in microseconds.
+ */
+bool writeChromeTrace(const char *path)
+{
+    std::vector<ProfileSample> samples;
+    snapshotProfileSamples(&samples);
+
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return false;
+
+    fprintf(file, "{\"traceEvents\": [\n");
+    for (size_t i = 0; i < samples.size(); i++)
+        fprintf(file, "  {\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, "
+            "\"tid\": %u, \"ts\": %.3f, \"dur\": %.3f}%s\n",
+            ZONE_NAMES[samples[i].zone], samples[i].thread,
+            samples[i].start / 1e3, samples[i].duration / 1e3,
+            i + 1 < samples.size() ? "," : "");
+    fprintf(file, "], \"displayTimeUnit\": \"ms\"}\n");
+
+    return fclose(file) == 0;
+}
+
+#ifndef CS3113_HEADLESS
+/**
+ * @brief Draws the frame-time graph (one bar per frame, 60 and 120 FPS budget
+ * lines), fixed steps per frame, and p50/p95/p99 per zone over the samples
+ * in the ring. Percentiles are refreshed a few times a second.
+ */
+void drawProfilerOverlay(int x, int y)
+{
+    constexpr int   GRAPH_HEIGHT = 80;
+    constexpr float GRAPH_MS     = 33.3f; // top of the graph
+    constexpr int   REFRESH      = 30;    // frames between percentile updates
+
+    static float percentiles[ZONE_COUNT][3];
+    static int   counts[ZONE_COUNT];
+    static int   lastRefresh = -REFRESH;
+
+    if (gFrameCount - lastRefresh >= REFRESH)
+    {
+        lastRefresh = gFrameCount;
+
+        std::vector<ProfileSample> samples;
+        snapshotProfileSamples(&samples);
+
+        std::vector<float> durations;
+        for (int zone = 0; zone < ZONE_COUNT; zone++)
+        {
+            durations.clear();
+            for (size_t i = 0; i < samples.size(); i++)
+                if (samples[i].zone == zone) durations.push_back(samples[i].duration / 1e6f);
+
+            counts[zone] = (int) durations.size();
+            if (durations.empty()) continue;
+
+            std::sort(durations.begin(), durations.end());
+            percentiles[zone][0] = durations[durations.size() * 50 / 100];
+            percentiles[zone][1] = durations[durations.size() * 95 / 100];
+            percentiles[zone][2] = durations[durations.size() * 99 / 100];
+        }
+    }
+
+    int frames = std::min(gFrameCount, PROFILE_FRAME_HISTORY);
+
+    DrawRectangle(x, y, PROFILE_FRAME_HISTORY, GRAPH_HEIGHT + 150, Fade(BLACK, 0.7f));
+
+    // ––––– FRAME GRAPH ––––– //
+    int maxSteps = 0;
+    for (int i = 0; i < frames; i++)
+    {
+        int   frame = (gFrameCount - frames + i) % PROFILE_FRAME_HISTORY;
+        float time  = std::min(gFrameTimes[frame], GRAPH_MS);
+        int   bar   = (int) (time / GRAPH_MS * GRAPH_HEIGHT);
+
+        // frames that caught up on more than one fixed step stand out
+        Color colour = gFrameSteps[frame] > 1 ? ORANGE : GREEN;
+        DrawLine(x + i, y + GRAPH_HEIGHT, x + i, y + GRAPH_HEIGHT - bar, colour);
+
+        maxSteps = std::max(maxSteps, gFrameSteps[frame]);
+    }
+
+    int line60  = y + GRAPH_HEIGHT - (int) (16.7f / GRAPH_MS * GRAPH_HEIGHT);
+    int line120 = y + GRAPH_HEIGHT - (int) (8.3f / GRAPH_MS * GRAPH_HEIGHT);
+    DrawLine(x, line60, x + PROFILE_FRAME_HISTORY, line60, RED);
+    DrawLine(x, line120, x + PROFILE_FRAME_HISTORY, line120, YELLOW);
+
+    // ––––– NUMBERS ––––– //
+    int textY = y + GRAPH_HEIGHT + 4;
+    int last  = frames > 0 ? (gFrameCount - 1) % PROFILE_FRAME_HISTORY : 0;
+
+    DrawText(TextFormat("frame %.2fms  steps %d (max %d)",
+        frames > 0 ? gFrameTimes[last] : 0.0f, frames > 0 ? gFrameSteps[last] : 0,
+        maxSteps), x + 4, textY, 10, WHITE);
+    DrawText("zone            p50     p95     p99 (ms)", x + 4, textY + 14, 10, GRAY);
+
+    for (int zone = 0; zone < ZONE_COUNT; zone++)
+    {
+        if (counts[zone] == 0) continue;
+
+        textY += 14;
+        DrawText(TextFormat("%-14s %6.3f  %6.3f  %6.3f", ZONE_NAMES[zone],
+            percentiles[zone][0], percentiles[zone][1], percentiles[zone][2]),
+            x + 4, textY + 14, 10, WHITE);
+    }
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "cs3113.h"
+#include <stdint.h>
+
+/**
+ * Low-overhead scoped timers. A `ProfileScope` records how long its scope
+ * took into a fixed-size lock-free ring buffer, which any thread may write
+ * to; the newest PROFILE_CAPACITY samples are kept. From there they can be
+ * shown as an overlay (frame-time graph, per-zone percentiles and fixed
+ * steps per frame) or written out as a Chrome trace (chrome://tracing or
+ * ui.perfetto.dev).
+ *
+ * Profiling is off until `setProfilerEnabled(true)`; until then a scope costs
+ * one relaxed atomic load.
+ */
+
+enum ProfileZone
+{
+    ZONE_FRAME,
+    ZONE_INPUT,
+    ZONE_UPDATE,
+    ZONE_STEP,           // one fixed step
+    ZONE_COLLISION,      // map and entity collision checks
+    ZONE_MAP_RENDER,
+    ZONE_ENTITY_RENDER,
+    ZONE_AUTOPILOT,      // planning, on the main thread's budget
+    ZONE_PARTICLES,      // particle emission and integration
+    ZONE_COUNT
+};
+
+struct ProfileSample
+{
+    ProfileZone zone;
+    uint32_t    thread;
+    uint64_t    start;    // ns since the profiler's epoch
+    uint64_t    duration; // ns
+};
+
+constexpr int PROFILE_CAPACITY      = 1 << 15; // samples, a power of two
+constexpr int PROFILE_FRAME_HISTORY = 240;     // frames kept for the graph
+
+const char *profileZoneName(ProfileZone zone);
+
+void     setProfilerEnabled(bool enabled);
+bool     isProfilerEnabled();
+uint64_t profilerNow();
+void     recordProfileSample(ProfileZone zone, uint64_t start, uint64_t end);
+void     markProfilerFrame(int fixedSteps);
+void     snapshotProfileSamples(std::vector<ProfileSample> *samples);
+bool     writeChromeTrace(const char *path);
+
+#ifndef CS3113_HEADLESS
+void drawProfilerOverlay(int x, int y);
+#endif
+
+class ProfileScope
+{
+private:
+    ProfileZone mZone;
+    uint64_t    mStart;
+
+public:
+    explicit ProfileScope(ProfileZone zone) : mZone {zone},
+        mStart {isProfilerEnabled() ? profilerNow() : 0} { }
+
+    ~ProfileScope()
+    {
+        if (mStart != 0) recordProfileSample(mZone, mStart, profilerNow());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b)  PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(zone) ProfileScope PROFILE_CONCAT(profileScope, __LINE__) (zone)
+
+#endif // PROFILER_H
@@ -0,0 +1,24 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/*
+    splitmix64: a 64-bit state per stream, cheap to seed and well mixed.
+    Shared by everything that needs reproducible randomness from a seed.
+*/
+static inline uint64_t nextRandom(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// uniform in [0, 1), from the top 24 bits
+static inline float nextUniform(uint64_t *state)
+{
+    return (nextRandom(state) >> 40) / 16777216.0f;
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,293 @@
+#include "Replay.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char REPLAY_MAGIC[4] = { 'L', 'L', 'R', 'P' };
+
+constexpr int REPLAY_SYMBOL_BITS = 3;
+constexpr int REPLAY_MAX_RUN_BITS = 32;
+
+// rotate (-1, 0, 1) and boost packed into one of six symbols
+static unsigned int inputSymbol(LanderInput input)
+{
+    int rotate = input.rotate < 0 ? 0 : input.rotate > 0 ? 2 : 1;
+    return (unsigned int) rotate * 2 + (input.boost ? 1 : 0);
+}
+
+static LanderInput symbolInput(unsigned int symbol)
+{
+    LanderInput input = { (int) (symbol / 2) - 1, (symbol & 1) != 0 };
+    return input;
+}
+
+/* ----------- RECORDING ----------- */
+
+static void writeBits(Replay *replay, uint32_t value, int bits)
+{
+    for (int i = bits - 1; i >= 0; i--)
+    {
+        uint32_t bit = replay->header.inputBits++;
+        if (bit / 8 >= replay->inputs.size()) replay->inputs.push_back(0);
+
+        if ((value >> i) & 1) replay->inputs[bit / 8] |= 0x80 >> (bit % 8);
+    }
+}
+
+/**
+ * @brief Appends one run: its symbol, then its length as an Elias gamma code
+ * (n zeros, then the length's n + 1 significant bits).
+ */
+static void writeRun(Replay *replay, unsigned int symbol, uint32_t length)
+{
+    if (length == 0) return;
+
+    int significantBits = 0;
+    while ((length >> significantBits) > 1) significantBits++;
+
+    writeBits(replay, symbol, REPLAY_SYMBOL_BITS);
+    writeBits(replay, 0, significantBits);
+    writeBits(replay, length, significantBits + 1);
+}
+
+/**
+ * @brief Starts a new recording from the simulation's current state, which
+ * should be its starting state.
+ */
+void ReplayRecorder::begin(Simulation &simulation, float deltaTime)
+{
+    ReplayHeader &header = mReplay.header;
+    const LanderState &lander = simulation.getLander();
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, REPLAY_MAGIC, sizeof(header.magic));
+    header.version             = REPLAY_VERSION;
+    header.levelHash           = hashLevel(simulation.getMap());
+    header.gravity             = simulation.getGravity();
+    header.deltaTime           = deltaTime;
+    header.continuousCollision = simulation.hasContinuousCollision();
+    header.fixedPoint          = simulation.hasFixedPoint();
+    header.landerPosition      = lander.position;
+    header.landerDimensions    = lander.colliderDimensions;
+    header.ufoPosition         = simulation.getUfo().basePosition;
+    header.ufoDimensions       = simulation.getUfo().colliderDimensions;
+
+    mReplay.inputs.clear();
+    mRunLength = 0;
+}
+
+void ReplayRecorder::record(LanderInput input)
+{
+    unsigned int symbol = inputSymbol(input);
+
+    if (mRunLength > 0 && (symbol != mRunSymbol || mRunLength == UINT32_MAX))
+    {
+        writeRun(&mReplay, mRunSymbol, mRunLength);
+        mRunLength = 0;
+    }
+
+    mRunSymbol = symbol;
+    mRunLength++;
+    mReplay.header.stepCount++;
+}
+
+/**
+ * @brief The recording so far, with the simulation's current state stamped
+ * as its outcome. Recording can carry on afterwards.
+ */
+Replay ReplayRecorder::finish(const Simulation &simulation) const
+{
+    Replay replay = mReplay;
+    writeRun(&replay, mRunSymbol, mRunLength);
+
+    const LanderState &lander = simulation.getLander();
+    replay.header.finalStatus   = lander.collisionStatus;
+    replay.header.finalPosition = lander.position;
+    replay.header.finalVelocity = lander.velocity;
+    replay.header.finalFuel     = lander.fuel;
+
+    return replay;
+}
+
+/* ----------- LEVEL HASH ----------- */
+
+static void hashBytes(uint64_t *hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *) data;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        *hash ^= bytes[i];
+        *hash *= 1099511628211ULL; // FNV-1a
+    }
+}
+
+/**
+ * @brief Fingerprint of a map's grid and tiles, so a replay is never checked
+ * against a level it wasn't recorded on. Streamed maps are paged through a
+ * block at a time, which can evict chunks the caller had resident.
+ */
+uint64_t hashLevel(Map *map)
+{
+    uint64_t hash = 14695981039346656037ULL;
+
+    int   columns  = map->getMapColumns();
+    int   rows     = map->getMapRows();
+    float tileSize = map->getTileSize();
+
+    hashBytes(&hash, &columns, sizeof(columns));
+    hashBytes(&hash, &rows, sizeof(rows));
+    hashBytes(&hash, &tileSize, sizeof(tileSize));
+
+    const int block = Map::RENDER_CHUNK_TILES;
+
+    for (int blockRow = 0; blockRow < rows; blockRow += block)
+    {
+        for (int blockColumn = 0; blockColumn < columns; blockColumn += block)
+        {
+            float left = map->getLeftBoundary() + blockColumn * tileSize;
+            float top  = map->getTopBoundary() + blockRow * tileSize;
+            map->streamAround(left, top, left + (block - 1) * tileSize,
+                top + (block - 1) * tileSize);
+
+            for (int row = blockRow; row < blockRow + block && row < rows; row++)
+            {
+                for (int col = blockColumn; col < blockColumn + block && col < columns; col++)
+                {
+                    unsigned char tile = (unsigned char) map->getTile(col, row);
+                    hashBytes(&hash, &tile, sizeof(tile));
+                }
+            }
+        }
+    }
+
+    return hash;
+}
+
+/* ----------- FILES ----------- */
+
+bool saveReplay(const char *path, const Replay &replay)
+{
+    FILE *file = fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    bool ok = fwrite(&replay.header, sizeof(ReplayHeader), 1, file) == 1 &&
+        fwrite(replay.inputs.data(), 1, replay.inputs.size(), file) ==
+            replay.inputs.size();
+
+    return fclose(file) == 0 && ok;
+}
+
+bool loadReplay(const char *path, Replay *replay)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+
+    bool ok = fread(&replay->header, sizeof(ReplayHeader), 1, file) == 1 &&
+        memcmp(replay->header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) == 0 &&
+        replay->header.version == REPLAY_VERSION;
+
+    if (ok)
+    {
+        replay->inputs.resize((replay->header.inputBits + 7) / 8);
+        ok = fread(replay->inputs.data(), 1, replay->inputs.size(), file) ==
+            replay->inputs.size();
+    }
+
+    fclose(file);
+    return ok;
+}
+
+/* ----------- PLAYBACK ----------- */
+
+/**
+ * @brief Expands a replay's input stream into one input per step.
+ *
+ * @return false if the stream is truncated, holds an unknown symbol, or does
+ * not add up to the header's step count.
+ */
+bool decodeReplayInputs(const Replay &replay, std::vector<LanderInput> *inputs)
+{
+    const uint32_t totalBits = replay.header.inputBits;
+    const unsigned char *data = replay.inputs.data();
+    uint32_t bit = 0;
+
+    if ((totalBits + 7) / 8 > replay.inputs.size()) return false;
+
+    inputs->clear();
+    inputs->reserve(replay.header.stepCount);
+
+    while (bit < totalBits)
+    {
+        if (totalBits - bit < REPLAY_SYMBOL_BITS) return false;
+
+        unsigned int symbol = 0;
+        for (int i = 0; i < REPLAY_SYMBOL_BITS; i++, bit++)
+            symbol = (symbol << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 1);
+
+        int zeros = 0;
+        while (bit < totalBits && !((data[bit / 8] >> (7 - bit % 8)) & 1))
+        {
+            zeros++;
+            bit++;
+        }
+
+        if (symbol > 5 || zeros >= REPLAY_MAX_RUN_BITS || totalBits - bit < (uint32_t) zeros + 1)
+            return false;
+
+        uint32_t run = 0;
+        for (int i = 0; i <= zeros; i++, bit++)
+            run = (run << 1) | ((data[bit / 8] >> (7 - bit % 8)) & 1);
+
+        if (inputs->size() + run > replay.header.stepCount) return false;
+        inputs->insert(inputs->end(), run, symbolInput(symbol));
+    }
+
+    return inputs->size() == replay.header.stepCount;
+}
+
+/**
+ * @brief Re-runs a replay on `simulation`, as fast as it will step, and
+ * checks that it ends exactly where the recording did (bit for bit).
+ *
+ * The simulation must be set up like the recorded one: same level, gravity,
+ * lander collider and UFO. It is reset to the replay's start first, and is
+ * left at the replay's end.
+ */
+ReplayCheck verifyReplay(const Replay &replay, Simulation *simulation)
+{
+    const ReplayHeader &header = replay.header;
+
+    if (hashLevel(simulation->getMap()) != header.levelHash)
+        return REPLAY_LEVEL_MISMATCH;
+
+    const LanderState &lander = simulation->getLander();
+    const UfoState    &ufo    = simulation->getUfo();
+
+    if (simulation->getGravity() != header.gravity ||
+        lander.colliderDimensions.x != header.landerDimensions.x ||
+        lander.colliderDimensions.y != header.landerDimensions.y ||
+        ufo.basePosition.x != header.ufoPosition.x ||
+        ufo.basePosition.y != header.ufoPosition.y ||
+        ufo.colliderDimensions.x != header.ufoDimensions.x ||
+        ufo.colliderDimensions.y != header.ufoDimensions.y)
+        return REPLAY_CONFIG_MISMATCH;
+
+    std::vector<LanderInput> inputs;
+    if (!decodeReplayInputs(replay, &inputs)) return REPLAY_CORRUPT;
+
+    simulation->setContinuousCollision(header.continuousCollision != 0);
+    simulation->setFixedPoint(header.fixedPoint != 0);
+    simulation->reset(header.landerPosition);
+
+    for (size_t i = 0; i < inputs.size(); i++)
+        simulation->step(inputs[i], header.deltaTime);
+
+    bool matches =
+        simulation->getStepCount()     == (int) header.stepCount &&
+        lander.collisionStatus         == (CollisionStatus) header.finalStatus &&
+        memcmp(&lander.position, &header.finalPosition, sizeof(Vector2)) == 0 &&
+        memcmp(&lander.velocity, &header.finalVelocity, sizeof(Vector2)) == 0 &&
+        memcmp(&lander.fuel, &header.finalFuel, sizeof(float)) == 0;
+
+    return matches ? REPLAY_OK : REPLAY_DESYNC;
+}
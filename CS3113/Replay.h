@@ -0,0 +1,91 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "Simulation.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * Replay file (.rpl): a ReplayHeader followed by the recorded inputs. The
+ * header pins down everything a run depends on besides its inputs (which
+ * level, gravity, timestep, physics mode, where everything started) and what
+ * the run ended in, so a replay can be checked as well as watched.
+ *
+ * Inputs are stored once per fixed step, run-length encoded into a bit
+ * stream: each run is a 3-bit input symbol followed by its length as an
+ * Elias gamma code. A held key therefore costs a handful of bits however
+ * long it is held. All integers are little-endian.
+ */
+struct ReplayHeader
+{
+    char     magic[4]; // "LLRP"
+    uint32_t version;
+    uint64_t levelHash;
+
+    float    gravity;
+    float    deltaTime;
+    uint32_t continuousCollision;
+    uint32_t fixedPoint;
+
+    Vector2  landerPosition;
+    Vector2  landerDimensions;
+    Vector2  ufoPosition;
+    Vector2  ufoDimensions;
+
+    // how the run ended
+    uint32_t stepCount;
+    uint32_t finalStatus;
+    Vector2  finalPosition;
+    Vector2  finalVelocity;
+    float    finalFuel;
+
+    uint32_t inputBits; // length of the input stream that follows
+};
+
+struct Replay
+{
+    ReplayHeader header;
+    std::vector<unsigned char> inputs;
+};
+
+enum ReplayCheck
+{
+    REPLAY_OK,
+    REPLAY_LEVEL_MISMATCH,  // recorded on a different level
+    REPLAY_CONFIG_MISMATCH, // gravity, colliders or the UFO differ
+    REPLAY_CORRUPT,         // the input stream does not decode
+    REPLAY_DESYNC           // replayed fine but ended somewhere else
+};
+
+constexpr uint32_t REPLAY_VERSION = 2;
+
+/**
+ * Logs one input per fixed step, as the simulation consumes them. Call
+ * `begin` with the simulation at its starting state, `record` before every
+ * `Simulation::step` that actually advances it, and `finish` at the end.
+ */
+class ReplayRecorder
+{
+private:
+    Replay mReplay;
+
+    unsigned int mRunSymbol = 0;
+    uint32_t     mRunLength = 0;
+
+public:
+    void begin(Simulation &simulation, float deltaTime);
+    void record(LanderInput input);
+    Replay finish(const Simulation &simulation) const;
+
+    uint32_t getStepCount() const { return mReplay.header.stepCount; }
+};
+
+uint64_t hashLevel(Map *map);
+
+bool saveReplay(const char *path, const Replay &replay);
+bool loadReplay(const char *path, Replay *replay);
+
+bool decodeReplayInputs(const Replay &replay, std::vector<LanderInput> *inputs);
+ReplayCheck verifyReplay(const Replay &replay, Simulation *simulation);
+
+#endif // REPLAY_H
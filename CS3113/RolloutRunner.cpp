@@ -0,0 +1,187 @@
+#include "RolloutRunner.h"
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+/**
+ * A worker's share of the chunk indices, [head, tail). The owner takes chunks
+ * from the head; thieves take the back half from the tail. Padded so that
+ * neighbouring workers' queues never share a cache line.
+ */
+struct ChunkQueue
+{
+    std::mutex mutex;
+    int head = 0;
+    int tail = 0;
+    char padding[64];
+
+    bool pop(int *chunk)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (head >= tail) return false;
+
+        *chunk = head++;
+        return true;
+    }
+
+    int remaining()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tail - head;
+    }
+};
+
+RolloutRunner::RolloutRunner(const Map *map, Vector2 colliderDimensions,
+    float gravity, int threadCount) : mMap {map},
+    mColliderDimensions {colliderDimensions}, mGravity {gravity},
+    mThreadCount {threadCount}
+{
+    if (mThreadCount <= 0) mThreadCount = (int) std::thread::hardware_concurrency();
+    if (mThreadCount <= 0) mThreadCount = 1;
+}
+
+/**
+ * @brief Steps episodes [begin, end) together as one batch until they have
+ * all finished or `maxSteps` is reached, then writes their results.
+ */
+void RolloutRunner::runChunk(LanderBatch *batch, const RolloutEpisode *episodes,
+    RolloutResult *results, int begin, int end, float deltaTime, int maxSteps,
+    std::vector<LanderInput> *inputs) const
+{
+    const int count = end - begin;
+
+    batch->clear();
+    for (int i = begin; i < end; i++)
+        batch->add(episodes[i].position, episodes[i].angle, episodes[i].fuel);
+
+    inputs->assign(count, LanderInput { 0, false });
+
+    // The UFO moves exactly the way it does in Simulation::step
+    float time = mUfoTime;
+    Vector2 ufoPosition = {
+        mUfo.basePosition.x,
+        mUfo.basePosition.y + sin(time) * mUfo.amplitude
+    };
+
+    for (int step = 0; step < maxSteps && batch->getPlayingCount() > 0; step++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            if (batch->getStatus(i) != PLAYING) continue;
+
+            const RolloutEpisode &episode = episodes[begin + i];
+
+            if (episode.controller)
+                (*inputs)[i] = episode.controller(batch->getLander(i), step);
+            else if (step < episode.scriptLength)
+                (*inputs)[i] = episode.script[step];
+            else
+                (*inputs)[i] = LanderInput { 0, false };
+        }
+
+        if (mHasUfo)
+        {
+            batch->step(inputs->data(), deltaTime, &ufoPosition,
+                &mUfo.colliderDimensions, 1);
+
+            time += deltaTime;
+            ufoPosition = {
+                mUfo.basePosition.x,
+                mUfo.basePosition.y + sin(time) * mUfo.amplitude
+            };
+        }
+        else batch->step(inputs->data(), deltaTime);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        RolloutResult &result = results[begin + i];
+
+        result.outcome           = batch->getStatus(i);
+        result.fuel              = batch->getFuel(i);
+        result.touchdownVelocity = batch->getVelocity(i);
+        result.steps             = batch->getStepCount(i);
+    }
+}
+
+/**
+ * @brief Rolls out every episode and returns one result per episode, in the
+ * same order. Blocks until all of them are done.
+ */
+std::vector<RolloutResult> RolloutRunner::run(
+    const std::vector<RolloutEpisode> &episodes, float deltaTime,
+    int maxSteps) const
+{
+    const int episodeCount = (int) episodes.size();
+    const int chunkCount   = (episodeCount + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int workerCount  = std::max(1, std::min(mThreadCount, chunkCount));
+
+    std::vector<RolloutResult> results(episodeCount);
+    if (episodeCount == 0) return results;
+
+    // Start every worker off with an even, contiguous share of the chunks
+    std::vector<ChunkQueue> queues(workerCount);
+    for (int w = 0; w < workerCount; w++)
+    {
+        queues[w].head = (int) ((long long) chunkCount * w / workerCount);
+        queues[w].tail = (int) ((long long) chunkCount * (w + 1) / workerCount);
+    }
+
+    auto worker = [&](int self)
+    {
+        LanderBatch batch(mMap, mColliderDimensions, mGravity);
+        batch.setContinuousCollision(mContinuousCollision);
+        std::vector<LanderInput> inputs;
+
+        while (true)
+        {
+            int chunk;
+
+            if (!queues[self].pop(&chunk))
+            {
+                // ––––– STEALING ––––– //
+                int victim = -1, most = 0;
+                for (int w = 0; w < workerCount; w++)
+                {
+                    if (w == self) continue;
+
+                    int remaining = queues[w].remaining();
+                    if (remaining > most) { most = remaining; victim = w; }
+                }
+
+                if (victim < 0) return; // nothing left anywhere
+
+                int stolenHead, stolenTail;
+                {
+                    std::lock_guard<std::mutex> lock(queues[victim].mutex);
+                    int remaining = queues[victim].tail - queues[victim].head;
+                    if (remaining <= 0) continue;
+
+                    stolenTail = queues[victim].tail;
+                    stolenHead = stolenTail - (remaining + 1) / 2;
+                    queues[victim].tail = stolenHead;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(queues[self].mutex);
+                    queues[self].head = stolenHead;
+                    queues[self].tail = stolenTail;
+                }
+                continue;
+            }
+
+            int begin = chunk * CHUNK_SIZE;
+            int end   = std::min(begin + CHUNK_SIZE, episodeCount);
+
+            runChunk(&batch, episodes.data(), results.data(), begin, end,
+                deltaTime, maxSteps, &inputs);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int w = 1; w < workerCount; w++) threads.push_back(std::thread(worker, w));
+    worker(0);
+
+    for (size_t t = 0; t < threads.size(); t++) threads[t].join();
+
+    return results;
+}
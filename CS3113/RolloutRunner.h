@@ -0,0 +1,81 @@
+#ifndef ROLLOUT_RUNNER_H
+#define ROLLOUT_RUNNER_H
+
+#include "LanderBatch.h"
+#include "Simulation.h"
+#include <functional>
+
+typedef std::function<LanderInput(const LanderState &lander, int step)>
+    LanderController;
+
+/**
+ * One episode to roll out: where the lander starts and what drives it. If a
+ * controller is set it is asked for input every step; otherwise the input
+ * script is replayed, holding no input once it runs out.
+ */
+struct RolloutEpisode
+{
+    Vector2 position;
+    float   angle = 0.0f;
+    float   fuel  = LANDER_STARTING_FUEL;
+
+    const LanderInput *script = nullptr;
+    int scriptLength = 0;
+
+    LanderController controller;
+};
+
+struct RolloutResult
+{
+    CollisionStatus outcome; // PLAYING if the episode ran out of steps
+    float   fuel;
+    Vector2 touchdownVelocity;
+    int     steps;
+};
+
+/**
+ * Spreads lander episodes across all cores. Episodes are handed out in small
+ * chunks; each worker steps its chunk as a `LanderBatch`, and idle workers
+ * steal half of the remaining chunks from the busiest-looking neighbour, so
+ * uneven episode lengths still keep every core busy.
+ *
+ * Nothing here touches raylib, so it runs on any thread.
+ */
+class RolloutRunner
+{
+private:
+    const Map *mMap;
+
+    Vector2 mColliderDimensions;
+    float   mGravity;
+    int     mThreadCount;
+
+    bool     mContinuousCollision = false;
+    bool     mHasUfo = false;
+    UfoState mUfo;
+    float    mUfoTime = 0.0f; // simulation time the episodes start at
+
+    void runChunk(LanderBatch *batch, const RolloutEpisode *episodes,
+        RolloutResult *results, int begin, int end, float deltaTime,
+        int maxSteps, std::vector<LanderInput> *inputs) const;
+
+public:
+    static constexpr int CHUNK_SIZE = 32;
+
+    RolloutRunner(const Map *map, Vector2 colliderDimensions,
+        float gravity = Simulation::DEFAULT_GRAVITY, int threadCount = 0);
+
+    // `time` is the Simulation's time when `ufo` was taken, so the UFO
+    // carries on from the same point in its swing
+    void setUfo(const UfoState &ufo, float time = 0.0f)
+        { mUfo = ufo; mUfoTime = time; mHasUfo = true; }
+    void clearUfo()                  { mHasUfo = false;             }
+    void setContinuousCollision(bool enabled) { mContinuousCollision = enabled; }
+
+    std::vector<RolloutResult> run(const std::vector<RolloutEpisode> &episodes,
+        float deltaTime, int maxSteps) const;
+
+    int getThreadCount() const { return mThreadCount; }
+};
+
+#endif // ROLLOUT_RUNNER_H
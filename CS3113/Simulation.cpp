@@ -0,0 +1,183 @@
+#include "Simulation.h"
+
+static const Fixed FIXED_RADIANS_TO_DEGREES = 3754936; // 180 / π
+
+Simulation::Simulation(Map *map, Vector2 landerPosition,
+    Vector2 landerDimensions, Vector2 ufoPosition, Vector2 ufoDimensions,
+    float gravity) : mMap {map}, mGravity {gravity}
+{
+    mLander.colliderDimensions = landerDimensions;
+
+    mUfo.basePosition       = ufoPosition;
+    mUfo.position           = ufoPosition;
+    mUfo.colliderDimensions = ufoDimensions;
+    mUfo.amplitude          = DEFAULT_UFO_AMPLITUDE;
+
+    reset(landerPosition);
+}
+
+Simulation::~Simulation() { delete mMap; }
+
+/**
+ * @brief Puts the lander back at `landerPosition` at rest with full fuel and
+ * rewinds simulation time; the map is left untouched.
+ */
+void Simulation::reset(Vector2 landerPosition)
+{
+    mLander.position        = landerPosition;
+    mLander.velocity        = { 0.0f, 0.0f };
+    mLander.acceleration    = { 0.0f, mGravity };
+    mLander.angle           = 0.0f;
+    mLander.rotation        = 0.0f;
+    mLander.fuel            = LANDER_STARTING_FUEL;
+    mLander.boosting        = false;
+    mLander.collisionStatus = PLAYING;
+
+    mUfo.position = mUfo.basePosition;
+
+    mTime      = 0.0f;
+    mStepCount = 0;
+
+    mFixedTime = 0;
+    toFixedLander(mLander, &mFixedLander);
+    if (mFixedPoint) 
+    {
+        fromFixedLander(mFixedLander, &mLander);
+        updateFixedUfo();
+    }
+}
+
+/**
+ * @brief Switches between float and fixed-point stepping. The lander carries
+ * on from where it is, rounded to fixed point when switching to it.
+ */
+void Simulation::setFixedPoint(bool enabled)
+{
+    if (enabled && !mFixedPoint)
+    {
+        toFixedLander(mLander, &mFixedLander);
+        fromFixedLander(mFixedLander, &mLander);
+        mFixedTime = toFixed(mTime);
+        updateFixedUfo();
+    }
+
+    mFixedPoint = enabled;
+}
+
+/**
+ * @brief Copies the simulation's state into `snapshot`. Settings (gravity,
+ * collision and fixed-point modes) are not part of it.
+ */
+void Simulation::save(GameSnapshot *snapshot) const
+{
+    snapshot->lander        = mLander;
+    snapshot->ufo           = mUfo;
+    snapshot->time          = mTime;
+    snapshot->stepCount     = mStepCount;
+    snapshot->fixedLander   = mFixedLander;
+    snapshot->fixedTime     = mFixedTime;
+    snapshot->fixedUfoY     = mFixedUfoY;
+    snapshot->tileEditCount  = (uint32_t) mMap->getTileEditCount();
+    snapshot->tileEditSerial = mMap->getTileEditSerial(mMap->getTileEditCount());
+}
+
+/**
+ * @brief Puts the simulation back the way it was when `snapshot` was saved,
+ * undoing map edits made since. Snapshots restore in any order as long as
+ * their edits haven't been undone already, e.g. by restoring an earlier one,
+ * even if as many new edits have been made since; otherwise nothing changes
+ * and this returns false.
+ */
+bool Simulation::restore(const GameSnapshot &snapshot)
+{
+    // the journal no longer holds the edits this snapshot was taken after
+    if (snapshot.tileEditCount > mMap->getTileEditCount() ||
+        mMap->getTileEditSerial(snapshot.tileEditCount) != snapshot.tileEditSerial)
+        return false;
+
+    if (snapshot.tileEditCount < mMap->getTileEditCount())
+        mMap->undoTileEdits(snapshot.tileEditCount);
+
+    mLander      = snapshot.lander;
+    mUfo         = snapshot.ufo;
+    mTime        = snapshot.time;
+    mStepCount   = snapshot.stepCount;
+    mFixedLander = snapshot.fixedLander;
+    mFixedTime   = snapshot.fixedTime;
+    mFixedUfoY   = snapshot.fixedUfoY;
+
+    return true;
+}
+
+// The UFO's bob, as in `step`, but with table trig on fixed-point time
+void Simulation::updateFixedUfo()
+{
+    mFixedUfoY = toFixed(mUfo.basePosition.y) + fixedMul(toFixed(mUfo.amplitude),
+        fixedSin(fixedMul(mFixedTime, FIXED_RADIANS_TO_DEGREES)));
+    mUfo.position = { mUfo.basePosition.x, fromFixed(mFixedUfoY) };
+}
+
+/**
+ * @brief Advances the whole simulation by one fixed step. Once the lander has
+ * won or lost, further steps do nothing, as in the game.
+ *
+ * @return the lander's collision status after the step.
+ */
+CollisionStatus Simulation::step(LanderInput input, float deltaTime)
+{
+    if (isGameOver()) return mLander.collisionStatus;
+
+    applyLanderInput(&mLander, input, mGravity);
+
+    // Streamed maps only hold chunks that have been asked for; page in
+    // everything the lander could touch this step
+    if (mMap->isStreamed())
+    {
+        float reachX = mLander.colliderDimensions.x / 2.0f + mMap->getTileSize() +
+            fabs(mLander.velocity.x + mLander.acceleration.x * deltaTime) * deltaTime;
+        float reachY = mLander.colliderDimensions.y / 2.0f + mMap->getTileSize() +
+            fabs(mLander.velocity.y + mLander.acceleration.y * deltaTime) * deltaTime;
+
+        mMap->streamAround(mLander.position.x - reachX, mLander.position.y - reachY,
+            mLander.position.x + reachX, mLander.position.y + reachY);
+    }
+
+    if (mFixedPoint)
+    {
+        FixedBox ufo = {
+            toFixed(mUfo.basePosition.x), mFixedUfoY,
+            toFixed(mUfo.colliderDimensions.x / 2.0f),
+            toFixed(mUfo.colliderDimensions.y / 2.0f)
+        };
+
+        stepLanderFixed(&mFixedLander, input, toFixed(mGravity),
+            toFixed(deltaTime), mMap, &ufo, 1);
+        fromFixedLander(mFixedLander, &mLander);
+
+        mFixedTime += toFixed(deltaTime);
+        mTime = fromFixed(mFixedTime);
+        updateFixedUfo();
+
+        mStepCount++;
+
+        return mLander.collisionStatus;
+    }
+
+    if (mContinuousCollision)
+        stepLanderContinuous(&mLander, deltaTime, mMap, &mUfo.position,
+            &mUfo.colliderDimensions, 1);
+    else
+        stepLander(&mLander, deltaTime, mMap, &mUfo.position,
+            &mUfo.colliderDimensions, 1);
+
+    // Simple moving platform
+    mTime += deltaTime;
+    mUfo.position = {
+        mUfo.basePosition.x,
+        mUfo.basePosition.y + sin(mTime) * mUfo.amplitude
+    };
+
+    mStepCount++;
+
+    return mLander.collisionStatus;
+}
@@ -0,0 +1,106 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include "FixedPhysics.h"
+#include <type_traits>
+
+/**
+ * The moving UFO hazard. It bobs vertically around `basePosition` as a sine
+ * of simulation time, the way `update()` in main.cpp used to move it.
+ */
+struct UfoState
+{
+    Vector2 basePosition;
+    Vector2 position;
+    Vector2 colliderDimensions;
+    float   amplitude;
+};
+
+/**
+ * Everything a `Simulation` changes as it steps, as plain data: copy it with
+ * `=` or memcpy, keep millions of them, and hand one back to `restore()` to
+ * continue from there. Map edits are not copied; the snapshot remembers how
+ * many the map's journal held, and restoring undoes any made since. A
+ * snapshot whose edits have since been undone can't be restored.
+ */
+struct GameSnapshot
+{
+    LanderState lander;
+    UfoState    ufo;
+    float       time;
+    int         stepCount;
+
+    FixedLanderState fixedLander;
+    Fixed            fixedTime;
+    Fixed            fixedUfoY;
+
+    uint32_t tileEditCount;
+    uint32_t tileEditSerial; // see Map::getTileEditSerial
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+    "GameSnapshot must stay memcpy-able");
+
+/**
+ * Headless simulation core: one map, one lander and one UFO, stepped at a
+ * fixed timestep. Makes no window, texture or GL calls, so it builds and runs
+ * with -DCS3113_HEADLESS on machines without raylib.
+ *
+ * The simulation owns its map and deletes it on destruction.
+ *
+ * In fixed-point mode (see FixedPhysics.h) the lander and UFO are stepped in
+ * fixed point and only mirrored into `getLander()`/`getUfo()`, so a run is
+ * bit-identical on every build. That mode always uses discrete collision.
+ */
+class Simulation
+{
+private:
+    Map *mMap;
+
+    LanderState mLander;
+    UfoState    mUfo;
+
+    float mGravity;
+    bool  mContinuousCollision = false;
+    float mTime = 0.0f;
+    int   mStepCount = 0;
+
+    bool             mFixedPoint = false;
+    FixedLanderState mFixedLander;
+    Fixed            mFixedTime = 0;
+    Fixed            mFixedUfoY = 0;
+
+    void updateFixedUfo();
+
+public:
+    static constexpr float DEFAULT_GRAVITY       = 10.0f;
+    static constexpr float DEFAULT_UFO_AMPLITUDE = 20.0f;
+
+    Simulation(Map *map, Vector2 landerPosition, Vector2 landerDimensions,
+        Vector2 ufoPosition, Vector2 ufoDimensions,
+        float gravity = DEFAULT_GRAVITY);
+    ~Simulation();
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    CollisionStatus step(LanderInput input, float deltaTime);
+    void reset(Vector2 landerPosition);
+    void setContinuousCollision(bool enabled) { mContinuousCollision = enabled; }
+    void setFixedPoint(bool enabled);
+
+    void save(GameSnapshot *snapshot) const;
+    bool restore(const GameSnapshot &snapshot);
+
+    Map               *getMap()       const { return mMap;                     }
+    const LanderState &getLander()    const { return mLander;                  }
+    const UfoState    &getUfo()       const { return mUfo;                     }
+    float              getGravity()   const { return mGravity;                 }
+    bool               hasContinuousCollision() const { return mContinuousCollision; }
+    bool               hasFixedPoint() const { return mFixedPoint;              }
+    float              getTime()      const { return mTime;                    }
+    int                getStepCount() const { return mStepCount;               }
+    bool               isGameOver()   const { return mLander.collisionStatus != PLAYING; }
+};
+
+#endif // SIMULATION_H
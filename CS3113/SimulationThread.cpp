@@ -0,0 +1,124 @@
+#include "SimulationThread.h"
+#include "Replay.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @brief Snapshots the simulation as it is now. Without a `previous` snapshot
+ * the previous positions are the current ones, so there is nothing to
+ * interpolate.
+ */
+SimulationSnapshot takeSnapshot(const Simulation &simulation,
+    const SimulationSnapshot *previous)
+{
+    SimulationSnapshot snapshot;
+    snapshot.lander    = simulation.getLander();
+    snapshot.ufo       = simulation.getUfo();
+    snapshot.time      = simulation.getTime();
+    snapshot.stepCount = simulation.getStepCount();
+    snapshot.steppedAt = std::chrono::steady_clock::now();
+
+    const SimulationSnapshot &before = previous != nullptr ? *previous : snapshot;
+    snapshot.previousLanderPosition = before.lander.position;
+    snapshot.previousLanderAngle    = before.lander.angle;
+    snapshot.previousUfoPosition    = before.ufo.position;
+
+    return snapshot;
+}
+
+SimulationThread::SimulationThread(Simulation *simulation, float deltaTime,
+    ReplayRecorder *recorder) : mSimulation {simulation}, mRecorder {recorder},
+    mDeltaTime {deltaTime}
+{
+    // so `latest()` has something to show before the first step
+    publish();
+}
+
+SimulationThread::~SimulationThread() { stop(); }
+
+void SimulationThread::publish()
+{
+    SimulationSnapshot snapshot = takeSnapshot(*mSimulation, 
+        mPublished ? &mLastSnapshot : nullptr);
+
+    mSnapshots.back() = snapshot;
+    mSnapshots.publish();
+
+    mLastSnapshot = snapshot;
+    mPublished    = true;
+}
+
+/**
+ * @brief How far the wall clock is into the step after `snapshot`, from 0 to
+ * 1, for interpolating between its previous and current positions.
+ */
+float SimulationThread::interpolation(const SimulationSnapshot &snapshot) const
+{
+    float elapsed = std::chrono::duration<float>(
+        std::chrono::steady_clock::now() - snapshot.steppedAt).count();
+
+    return std::min(std::max(elapsed / mDeltaTime, 0.0f), 1.0f);
+}
+
+void SimulationThread::start()
+{
+    if (mRunning.exchange(true)) return;
+    mThread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop()
+{
+    if (!mRunning.exchange(false)) return;
+    mThread.join();
+}
+
+/**
+ * @brief Steps on a fixed schedule, sleeping until each step is due. If the
+ * thread falls more than MAX_CATCH_UP steps behind (it was descheduled, or a
+ * debugger stopped it) the missed time is dropped rather than replayed in a
+ * burst.
+ */
+void SimulationThread::run()
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const Clock::duration step = std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<float>(mDeltaTime));
+
+    LanderInput input = { 0, false };
+    Clock::time_point due = Clock::now() + step;
+
+    while (mRunning.load(std::memory_order_relaxed))
+    {
+        std::this_thread::sleep_until(due);
+
+        if (Clock::now() - due > (int) MAX_CATCH_UP * step) due = Clock::now();
+        due += step;
+
+        // The latest input is held from here on, but a rotate or boost that
+        // came and went since the last step still gets this one
+        LanderInput pressed = { 0, false };
+        LanderInput next;
+        while (mInputs.pop(&next))
+        {
+            if (next.rotate != 0) pressed.rotate = next.rotate;
+            pressed.boost = pressed.boost || next.boost;
+            input = next;
+        }
+
+        LanderInput stepInput = input;
+        if (stepInput.rotate == 0) stepInput.rotate = pressed.rotate;
+        stepInput.boost = stepInput.boost || pressed.boost;
+
+        {
+            PROFILE_SCOPE(ZONE_STEP);
+
+            if (mRecorder != nullptr && !mSimulation->isGameOver())
+                mRecorder->record(stepInput);
+            mSimulation->step(stepInput, mDeltaTime);
+        }
+
+        publish();
+    }
+}
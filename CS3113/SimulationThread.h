@@ -0,0 +1,88 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include "Simulation.h"
+#include "LockFree.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class ReplayRecorder;
+
+/**
+ * What the renderer needs of one fixed step: the lander and UFO as they were
+ * after it, where they were before it (to interpolate from), and which step
+ * it was.
+ */
+struct SimulationSnapshot
+{
+    LanderState lander;
+    UfoState    ufo;
+    float       time;
+    int         stepCount;
+
+    Vector2 previousLanderPosition;
+    float   previousLanderAngle;
+    Vector2 previousUfoPosition;
+
+    std::chrono::steady_clock::time_point steppedAt;
+};
+
+/**
+ * Runs a `Simulation` on its own thread at exactly one step per `deltaTime`
+ * of wall-clock time, whatever the frame rate. Input goes in through a
+ * lock-free queue; each step uses the latest input that arrived before it,
+ * plus any rotate or boost pressed and released since the step before, so
+ * a tap between two steps is never lost.
+ * After every step the new state is published to a triple buffer, so
+ * `latest()` never waits on the simulation and never sees a half-written step.
+ *
+ * Between `start()` and `stop()` the simulation (and the recorder, if any)
+ * belong to the simulation thread; the caller must go through `pushInput()`
+ * and `latest()` only. The map may still be read, e.g. rendered, but not
+ * modified, and it must not be a streamed map, since streaming pages tiles in.
+ */
+class SimulationThread
+{
+private:
+    static constexpr unsigned int INPUT_CAPACITY = 256;
+    static constexpr int          MAX_CATCH_UP   = 8; // steps behind before giving up on them
+
+    Simulation     *mSimulation;
+    ReplayRecorder *mRecorder;
+    float           mDeltaTime;
+
+    SpscQueue<LanderInput, INPUT_CAPACITY> mInputs;
+    TripleBuffer<SimulationSnapshot>       mSnapshots;
+
+    SimulationSnapshot mLastSnapshot; // the simulation thread's copy
+    bool               mPublished = false;
+
+    std::thread       mThread;
+    std::atomic<bool> mRunning {false};
+
+    void run();
+    void publish();
+
+public:
+    SimulationThread(Simulation *simulation, float deltaTime,
+        ReplayRecorder *recorder = nullptr);
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void start();
+    void stop();
+
+    bool pushInput(LanderInput input) { return mInputs.push(input); }
+    const SimulationSnapshot &latest() { return mSnapshots.front(); }
+    float interpolation(const SimulationSnapshot &snapshot) const;
+
+    bool isRunning() const { return mRunning.load(std::memory_order_relaxed); }
+};
+
+SimulationSnapshot takeSnapshot(const Simulation &simulation,
+    const SimulationSnapshot *previous = nullptr);
+
+#endif // SIMULATION_THREAD_H
@@ -0,0 +1,107 @@
+#include "SpatialHash.h"
+
+constexpr uint32_t MIN_BUCKETS = 16;
+
+SpatialHash::SpatialHash(float cellSize, Vector2 origin) :
+    mCellSize {cellSize}, mInverseCellSize {1.0f / cellSize}, mOrigin {origin} {}
+
+/**
+ * @brief Sets the cell size and where cell (0, 0) starts, e.g. a map's tile
+ * size and top-left corner. Takes effect from the next `build`.
+ */
+void SpatialHash::setGrid(float cellSize, Vector2 origin)
+{
+    mCellSize        = cellSize;
+    mInverseCellSize = 1.0f / cellSize;
+    mOrigin          = origin;
+    clear();
+}
+
+void SpatialHash::clear()
+{
+    mItems.clear();
+    mBucketMask = 0;
+}
+
+// floorf is a library call without SSE4.1, and this runs per box per query
+static inline int floorToInt(float value)
+{
+    int truncated = (int) value;
+    return truncated - (value < (float) truncated);
+}
+
+/**
+ * @brief The cells a box overlaps. Every box is widened by a sliver of a
+ * cell first, so one that only overlaps another through rounding (the exact
+ * tests work in floats too) still lands in a cell the other is looked up in.
+ */
+SpatialHash::CellRange SpatialHash::getCells(Vector2 position,
+    Vector2 dimensions) const
+{
+    float halfWidth  = dimensions.x / 2.0f + mCellSize / 1024.0f;
+    float halfHeight = dimensions.y / 2.0f + mCellSize / 1024.0f;
+    float x = position.x - mOrigin.x;
+    float y = position.y - mOrigin.y;
+
+    return {
+        floorToInt((x - halfWidth)  * mInverseCellSize),
+        floorToInt((y - halfHeight) * mInverseCellSize),
+        floorToInt((x + halfWidth)  * mInverseCellSize),
+        floorToInt((y + halfHeight) * mInverseCellSize)
+    };
+}
+
+uint32_t SpatialHash::getBucket(int column, int row) const
+{
+    uint32_t hash = (uint32_t) column * 73856093u ^ (uint32_t) row * 19349663u;
+    return (hash ^ (hash >> 16)) & mBucketMask;
+}
+
+/**
+ * @brief Replaces the contents with `count` boxes, box i centred on
+ * `positions[i]` with size `dimensions[i]`. Queries return these indices.
+ */
+void SpatialHash::build(const Vector2 *positions, const Vector2 *dimensions,
+    int count)
+{
+    // ––––– SIZING ––––– //
+    int entries = 0;
+    for (int i = 0; i < count; i++)
+    {
+        CellRange cells = getCells(positions[i], dimensions[i]);
+        entries += (cells.right - cells.left + 1) * (cells.bottom - cells.top + 1);
+    }
+
+    // about two buckets per entry keeps unrelated cells from sharing
+    uint32_t buckets = MIN_BUCKETS;
+    while (buckets < 2u * (uint32_t) entries) buckets *= 2;
+    mBucketMask = buckets - 1;
+
+    mBucketStarts.assign(buckets + 1, 0);
+    mItems.resize(entries);
+
+    // ––––– COUNTING ––––– //
+    for (int i = 0; i < count; i++)
+    {
+        CellRange cells = getCells(positions[i], dimensions[i]);
+
+        for (int row = cells.top; row <= cells.bottom; row++)
+            for (int column = cells.left; column <= cells.right; column++)
+                mBucketStarts[getBucket(column, row) + 1]++;
+    }
+
+    for (uint32_t bucket = 0; bucket < buckets; bucket++)
+        mBucketStarts[bucket + 1] += mBucketStarts[bucket];
+
+    // ––––– BINNING ––––– //
+    mBucketFill.assign(mBucketStarts.begin(), mBucketStarts.end() - 1);
+
+    for (int i = 0; i < count; i++)
+    {
+        CellRange cells = getCells(positions[i], dimensions[i]);
+
+        for (int row = cells.top; row <= cells.bottom; row++)
+            for (int column = cells.left; column <= cells.right; column++)
+                mItems[mBucketFill[getBucket(column, row)]++] = i;
+    }
+}
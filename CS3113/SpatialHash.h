@@ -0,0 +1,78 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include "cs3113.h"
+#include <stdint.h>
+
+/**
+ * Broadphase for box-against-box tests: a uniform grid of square cells,
+ * normally one map tile each, hashed into a power-of-two number of buckets
+ * so boxes can sit anywhere, off the map included. `build` throws away what
+ * was there and bins every box into each cell it covers with a counting
+ * sort: two passes over the boxes, and no allocation once the arrays have
+ * grown to fit. Meant to be rebuilt every fixed step.
+ *
+ * Queries only narrow things down. `findFirst` hands the caller's exact
+ * test the boxes in the cells a query box covers, plus whatever else shares
+ * their buckets, and the same box more than once if it spans several cells.
+ */
+class SpatialHash
+{
+private:
+    struct CellRange { int left, top, right, bottom; };
+
+    float    mCellSize;
+    float    mInverseCellSize;
+    Vector2  mOrigin;
+    uint32_t mBucketMask = 0;
+
+    std::vector<int> mBucketStarts; // into mItems, plus one past the last bucket
+    std::vector<int> mBucketFill;   // build scratch
+    std::vector<int> mItems;        // box indices, grouped by bucket
+
+    CellRange getCells(Vector2 position, Vector2 dimensions) const;
+    uint32_t  getBucket(int column, int row) const;
+
+public:
+    SpatialHash(float cellSize = 1.0f, Vector2 origin = { 0.0f, 0.0f });
+
+    void setGrid(float cellSize, Vector2 origin);
+    void build(const Vector2 *positions, const Vector2 *dimensions, int count);
+    void clear();
+
+    template <typename Test>
+    int findFirst(Vector2 position, Vector2 dimensions, Test test) const;
+
+    float   getCellSize() const { return mCellSize; }
+    Vector2 getOrigin()   const { return mOrigin;   }
+    bool    isEmpty()     const { return mItems.empty(); }
+};
+
+/**
+ * @brief Runs `test(index)` on the boxes near the one centred on `position`
+ * until it returns true.
+ *
+ * @return the first index it accepted, or -1.
+ */
+template <typename Test>
+int SpatialHash::findFirst(Vector2 position, Vector2 dimensions, Test test) const
+{
+    if (mItems.empty()) return -1;
+
+    CellRange cells = getCells(position, dimensions);
+
+    for (int row = cells.top; row <= cells.bottom; row++)
+    {
+        for (int column = cells.left; column <= cells.right; column++)
+        {
+            uint32_t bucket = getBucket(column, row);
+
+            for (int k = mBucketStarts[bucket]; k < mBucketStarts[bucket + 1]; k++)
+                if (test(mItems[k])) return mItems[k];
+        }
+    }
+
+    return -1;
+}
+
+#endif // SPATIAL_HASH_H
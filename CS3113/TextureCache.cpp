@@ -0,0 +1,263 @@
+#include "TextureCache.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+enum TextureState { TEXTURE_DECODING, TEXTURE_READY, TEXTURE_FAILED };
+
+struct TextureEntry
+{
+    const std::string path;
+    TextureState state;
+    int          references; // handles to it
+    Texture2D    texture;
+};
+
+struct DecodedImage
+{
+    TextureEntry *entry;
+    Image         image; // no data if the file could not be decoded
+};
+
+// Shown while a texture is still loading, or in place of one that failed
+static const Color PLACEHOLDER_COLOUR = { 255, 255, 255, 40 };
+
+// ––––– MAIN THREAD ONLY ––––– //
+static std::map<std::string, TextureEntry *> gEntries;
+static Texture2D gPlaceholder = {};
+static int       gDecodingCount = 0;
+static std::vector<DecodedImage> gUploads;
+
+// ––––– SHARED WITH THE DECODER, UNDER gMutex ––––– //
+static std::mutex                 gMutex;
+static std::condition_variable    gRequested;
+static std::condition_variable    gDecodedSignal;
+static std::deque<TextureEntry *> gRequests;
+static std::vector<DecodedImage>  gDecoded;
+static bool                       gStopping = false;
+
+static void stopDecoder();
+
+// Stops the decoder if the program ends without `shutdownTextureCache`: a
+// std::thread still joinable when destroyed would call std::terminate
+struct DecoderThread
+{
+    std::thread thread;
+    ~DecoderThread() { stopDecoder(); }
+};
+
+static DecoderThread gDecoder;
+
+/**
+ * @brief The worker: decodes requested files into CPU-side images, one at a
+ * time, until told to stop. An entry's path never changes, so reading it
+ * here without the lock is safe.
+ */
+static void decodeRequests()
+{
+    std::unique_lock<std::mutex> lock(gMutex);
+
+    while (true)
+    {
+        gRequested.wait(lock, [] { return gStopping || !gRequests.empty(); });
+        if (gStopping) return;
+
+        TextureEntry *entry = gRequests.front();
+        gRequests.pop_front();
+
+        lock.unlock();
+        Image image = LoadImage(entry->path.c_str());
+        lock.lock();
+
+        gDecoded.push_back({ entry, image });
+        gDecodedSignal.notify_all();
+    }
+}
+
+static void stopDecoder()
+{
+    if (!gDecoder.thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gStopping = true;
+    }
+    gRequested.notify_one();
+    gDecoder.thread.join();
+}
+
+static void destroyEntry(TextureEntry *entry)
+{
+    if (entry->state == TEXTURE_READY) UnloadTexture(entry->texture);
+
+    gEntries.erase(entry->path);
+    delete entry;
+}
+
+/* ----------- TEXTURE HANDLE ----------- */
+
+TextureHandle::TextureHandle(TextureEntry *entry) : mEntry {entry}
+{
+    if (mEntry != nullptr) mEntry->references++;
+}
+
+TextureHandle::TextureHandle(const TextureHandle &other) : mEntry {other.mEntry}
+{
+    if (mEntry != nullptr) mEntry->references++;
+}
+
+TextureHandle::TextureHandle(TextureHandle &&other) : mEntry {other.mEntry}
+{
+    other.mEntry = nullptr;
+}
+
+TextureHandle &TextureHandle::operator=(TextureHandle other)
+{
+    std::swap(mEntry, other.mEntry);
+    return *this;
+}
+
+/**
+ * @brief Drops this handle's reference. A texture still being decoded is
+ * left for `uploadLoadedTextures` to destroy once the decoder is done with
+ * it, unless some new handle has taken it up by then.
+ */
+void TextureHandle::release()
+{
+    if (mEntry == nullptr) return;
+
+    if (--mEntry->references == 0 && mEntry->state != TEXTURE_DECODING)
+        destroyEntry(mEntry);
+
+    mEntry = nullptr;
+}
+
+const Texture2D &TextureHandle::get() const
+{
+    static const Texture2D NO_TEXTURE = {};
+
+    if (mEntry == nullptr) return NO_TEXTURE;
+
+    return mEntry->state == TEXTURE_READY ? mEntry->texture : gPlaceholder;
+}
+
+bool TextureHandle::isLoaded() const
+{
+    return mEntry != nullptr && mEntry->state == TEXTURE_READY;
+}
+
+/* ----------- CACHE ----------- */
+
+/**
+ * @brief A handle to the texture at `filePath`: the cached one if it is
+ * already loaded or loading, otherwise a new one whose decoding is queued.
+ * Needs the window (and its GL context) to be open.
+ */
+TextureHandle loadTextureAsync(const char *filePath)
+{
+    if (gPlaceholder.id == 0)
+    {
+        Image image  = GenImageColor(1, 1, PLACEHOLDER_COLOUR);
+        gPlaceholder = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+
+    auto found = gEntries.find(filePath);
+    if (found != gEntries.end()) return TextureHandle(found->second);
+
+    TextureEntry *entry = new TextureEntry { filePath, TEXTURE_DECODING, 0, {} };
+    gEntries[entry->path] = entry;
+    gDecodingCount++;
+
+    if (!gDecoder.thread.joinable())
+    {
+        gStopping       = false;
+        gDecoder.thread = std::thread(decodeRequests);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        gRequests.push_back(entry);
+    }
+    gRequested.notify_one();
+
+    return TextureHandle(entry);
+}
+
+/**
+ * @brief Uploads whatever the decoder has finished since the last call to
+ * the GPU, from then on replacing the placeholder wherever it is drawn.
+ */
+void uploadLoadedTextures()
+{
+    {
+        std::lock_guard<std::mutex> lock(gMutex);
+        if (gDecoded.empty()) return;
+        gUploads.swap(gDecoded);
+    }
+
+    for (DecodedImage &decoded : gUploads)
+    {
+        TextureEntry *entry = decoded.entry;
+        gDecodingCount--;
+
+        // no point uploading it if every handle went while it was decoding
+        if (decoded.image.data == nullptr || entry->references == 0)
+            entry->state = TEXTURE_FAILED;
+        else
+        {
+            entry->texture = LoadTextureFromImage(decoded.image);
+            entry->state   = TEXTURE_READY;
+        }
+
+        if (decoded.image.data != nullptr) UnloadImage(decoded.image);
+        if (entry->references == 0) destroyEntry(entry);
+    }
+
+    gUploads.clear();
+}
+
+/**
+ * @brief Blocks until every texture asked for so far has been uploaded (or
+ * has failed), e.g. before the first frame of a level.
+ */
+void waitForTextures()
+{
+    while (gDecodingCount > 0)
+    {
+        {
+            std::unique_lock<std::mutex> lock(gMutex);
+            gDecodedSignal.wait(lock, [] { return !gDecoded.empty(); });
+        }
+        uploadLoadedTextures();
+    }
+}
+
+/**
+ * @brief Stops the decoder and unloads everything still cached, including
+ * the placeholder. Call once every handle is gone, before the window closes.
+ */
+void shutdownTextureCache()
+{
+    stopDecoder();
+
+    for (DecodedImage &decoded : gDecoded)
+        if (decoded.image.data != nullptr) UnloadImage(decoded.image);
+    gDecoded.clear();
+    gRequests.clear();
+
+    for (auto &cached : gEntries)
+    {
+        if (cached.second->state == TEXTURE_READY)
+            UnloadTexture(cached.second->texture);
+        delete cached.second;
+    }
+    gEntries.clear();
+    gDecodingCount = 0;
+
+    if (gPlaceholder.id != 0) UnloadTexture(gPlaceholder);
+    gPlaceholder = {};
+}
+
+int getCachedTextureCount() { return (int) gEntries.size(); }
@@ -0,0 +1,47 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include "cs3113.h"
+
+struct TextureEntry;
+
+/**
+ * Shared, reference-counted handle to a texture in the cache. Copies share
+ * the one texture, which is unloaded when the last handle to it goes. Until
+ * the image has been decoded and uploaded `get()` returns a placeholder, so
+ * a handle can be drawn with from the moment it is made.
+ *
+ * Handles belong to the main (GL) thread: make, copy and drop them there.
+ */
+class TextureHandle
+{
+private:
+    TextureEntry *mEntry = nullptr;
+
+    void release();
+
+public:
+    TextureHandle() = default;
+    explicit TextureHandle(TextureEntry *entry);
+    TextureHandle(const TextureHandle &other);
+    TextureHandle(TextureHandle &&other);
+    TextureHandle &operator=(TextureHandle other);
+    ~TextureHandle() { release(); }
+
+    const Texture2D &get() const;
+    bool isLoaded() const;
+    bool isEmpty()  const { return mEntry == nullptr; }
+};
+
+/*
+    The cache itself, keyed by file path. PNGs are decoded on a worker thread;
+    only the GPU upload happens on the main thread, in `uploadLoadedTextures`,
+    which the game calls once a frame. All of these are main-thread only.
+*/
+TextureHandle loadTextureAsync(const char *filePath);
+void uploadLoadedTextures();
+void waitForTextures();
+void shutdownTextureCache();
+int  getCachedTextureCount();
+
+#endif // TEXTURE_CACHE_H
@@ -1,5 +1,6 @@
 #include "cs3113.h"
 
+#ifndef CS3113_HEADLESS
 Color ColorFromHex(const char *hex)
 {
     // Skip leading '#', if present
@@ -30,6 +31,7 @@ Color ColorFromHex(const char *hex)
     // Fallback – return white so you notice something went wrong
     return RAYWHITE;
 }
+#endif // CS3113_HEADLESS
 
 /**
  * @brief Calculates and returns the magnitude of a 2D vector.
@@ -82,6 +84,7 @@ void Normalise(Vector2 *vector)
  * x-coordinate, top-left y-coordinate, width, and height of the specified
  * portion of the texture.
  */
+#ifndef CS3113_HEADLESS
 Rectangle getUVRectangle(const Texture2D *texture, int index, int rows, int cols)
 {
     float uCoord = (float) (index % cols) / (float) cols;
@@ -99,4 +102,5 @@ Rectangle getUVRectangle(const Texture2D *texture, int index, int rows, int cols
         sliceWidth, // width of slice
         sliceHeight // height of slice
     };
-}
\ No newline at end of file
+}
+#endif // CS3113_HEADLESS
@@ -2,9 +2,13 @@
 #define CS3113_H
 #define LOG(argument) std::cout << argument << '\n'
 
+#ifdef CS3113_HEADLESS
+#include "Headless.h"
+#else
 #include "raylib.h"
 #include "rlgl.h"
 #include "raymath.h"
+#endif
 #include <math.h>
 #include <time.h>
 #include <stdio.h>
@@ -16,9 +20,12 @@
 enum AppStatus   { TERMINATED, RUNNING };
 enum TextureType { SINGLE, ATLAS       };
 
-Color ColorFromHex(const char *hex);
 void Normalise(Vector2 *vector);
 float GetLength(const Vector2 vector);
+
+#ifndef CS3113_HEADLESS
+Color ColorFromHex(const char *hex);
 Rectangle getUVRectangle(const Texture2D *texture, int index, int rows, int cols);
+#endif
 
 #endif // CS3113_H
\ No newline at end of file
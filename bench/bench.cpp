@@ -0,0 +1,499 @@
+/**
+ * Benchmark suite: micro benchmarks of the physics and collision hot paths,
+ * map rendering at several sizes, batched headless rollouts and a full game
+ * frame. Built and run by `make bench`.
+ *
+ *   bench_app [--json FILE] [--csv FILE] [--baseline FILE]
+ *             [--threshold PERCENT] [--filter TEXT]
+ *
+ * Each benchmark is timed over enough iterations to run for a while, five
+ * times, and the median is kept. With --baseline, results are compared to a
+ * previous --json run and the exit code is 1 if anything got slower by more
+ * than the threshold (15% by default).
+ *
+ * Rendering needs a GL context, so this opens a hidden window.
+ */
+
+#include "../CS3113/Entity.h"
+#include "../CS3113/LevelFile.h"
+#include "../CS3113/RolloutRunner.h"
+#include <algorithm>
+#include <chrono>
+#include <string.h>
+
+struct BenchResult
+{
+    std::string name;
+    double nsPerOp;
+    long long ops; // per sample
+};
+
+constexpr int    SAMPLES          = 5;
+constexpr double MIN_SAMPLE_TIME  = 0.1; // seconds
+constexpr float  TILE_SIZE        = 40.0f,
+                 FIXED_TIMESTEP   = 1.0f / 60.0f,
+                 GRAVITY          = 10.0f;
+constexpr int    SCREEN_WIDTH     = 1000,
+                 SCREEN_HEIGHT    = 600;
+
+std::vector<BenchResult> gResults;
+const char *gFilter = nullptr;
+volatile int gSink;
+
+/* ----------- HARNESS ----------- */
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Times `body(iterations)`, which must perform `iterations` operations
+ * (times `opsPerIteration`). Iterations are doubled until one sample takes at
+ * least MIN_SAMPLE_TIME; the median of SAMPLES samples is recorded.
+ */
+template <typename Body>
+void bench(const char *name, Body body, long long opsPerIteration = 1)
+{
+    if (gFilter != nullptr && strstr(name, gFilter) == nullptr) return;
+
+    long long iterations = 1;
+    body(1); // warm-up
+
+    while (true)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        if (secondsSince(start) >= MIN_SAMPLE_TIME || iterations >= (1LL << 40)) break;
+        iterations *= 2;
+    }
+
+    std::vector<double> samples;
+    for (int i = 0; i < SAMPLES; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        samples.push_back(secondsSince(start));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    long long ops = iterations * opsPerIteration;
+    BenchResult result = { name, samples[SAMPLES / 2] * 1e9 / ops, ops };
+    gResults.push_back(result);
+
+    printf("%-32s %12.2f ns/op  (%lld ops)\n", name, result.nsPerOp, ops);
+}
+
+/* ----------- FIXTURES ----------- */
+
+/**
+ * @brief A level like the game's: solid walls and ceiling, scattered rock
+ * (tiles 3 and 4) and a landing pad (tile 2) along the floor. Deterministic.
+ */
+static std::vector<unsigned int> makeLevel(int columns, int rows)
+{
+    std::vector<unsigned int> level(columns * rows, 0);
+    unsigned int seed = 12345;
+
+    for (int row = 0; row < rows; row++)
+    {
+        for (int col = 0; col < columns; col++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+
+            unsigned int &tile = level[row * columns + col];
+            if (row < 2 || col < 2 || col >= columns - 2) tile = 1;
+            else if (row == rows - 1) tile = (col % 10 < 2) ? 2 : 3;
+            else if ((seed >> 24) < 30) tile = 3 + (seed >> 8) % 2;
+        }
+    }
+
+    return level;
+}
+
+static std::vector<Vector2> randomPoints(const Map &map, int count)
+{
+    std::vector<Vector2> points(count);
+    unsigned int seed = 777;
+    float width  = map.getRightBoundary() - map.getLeftBoundary();
+    float height = map.getBottomBoundary() - map.getTopBoundary();
+
+    for (int i = 0; i < count; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float u = (seed >> 8) / 16777216.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float v = (seed >> 8) / 16777216.0f;
+
+        points[i] = { map.getLeftBoundary() + u * width, map.getTopBoundary() + v * height };
+    }
+
+    return points;
+}
+
+/* ----------- BENCHMARKS ----------- */
+
+static void benchPhysics()
+{
+    std::vector<unsigned int> level = makeLevel(30, 15);
+    Map map(30, 15, level.data(), TILE_SIZE, { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 });
+    Vector2 start = { 200.0f, 100.0f };
+
+    Entity lander;
+    lander.setPosition(start);
+    lander.setScale({ TILE_SIZE, TILE_SIZE });
+    lander.setColliderDimensions({ TILE_SIZE, TILE_SIZE });
+    lander.setAcceleration({ 0.0f, GRAVITY });
+
+    bench("entity_update", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++)
+        {
+            // Entity keeps falling once it has landed, so keep it on screen
+            if (i % 240 == 0) lander.setPosition(start);
+
+            lander.resetMovement();
+            if (i % 90 < 30) lander.rotateLeft();
+            if (i % 60 < 40) lander.boost();
+            lander.setAcceleration({ 0.0f, GRAVITY });
+            lander.update(FIXED_TIMESTEP, nullptr, &map, nullptr);
+        }
+        gSink = (int) lander.getPosition().y;
+    });
+
+    const int POINTS = 4096;
+    std::vector<Vector2> points = randomPoints(map, POINTS);
+
+    bench("map_get_tile_at", [&](long long iterations) {
+        int sum = 0;
+        for (long long i = 0; i < iterations; i++)
+            sum += map.getTileAt(points[i % POINTS]);
+        gSink = sum;
+    });
+
+    bench("check_collision_y", [&](long long iterations) {
+        int sum = 0;
+        for (long long i = 0; i < iterations; i++)
+            sum += checkMapCollisionY(&map, points[i % POINTS],
+                { TILE_SIZE, TILE_SIZE }, (i & 1) ? 1.0f : -1.0f, PLAYING);
+        gSink = sum;
+    });
+
+    bench("check_collision_x", [&](long long iterations) {
+        int sum = 0;
+        for (long long i = 0; i < iterations; i++)
+            sum += checkMapCollisionX(&map, points[i % POINTS],
+                { TILE_SIZE, TILE_SIZE }, (i & 1) ? 1.0f : -1.0f, PLAYING);
+        gSink = sum;
+    });
+
+    bench("simulation_step", [&](long long iterations) {
+        Simulation simulation(new Map(30, 15, level.data(), TILE_SIZE, map.getOrigin()),
+            start, { TILE_SIZE, TILE_SIZE }, { 300.0f, 300.0f },
+            { TILE_SIZE * 2.0f, TILE_SIZE * 2.0f }, GRAVITY);
+
+        for (long long i = 0; i < iterations; i++)
+        {
+            if (simulation.isGameOver()) simulation.reset(start);
+
+            LanderInput input = { i % 90 < 30 ? ROTATE_LEFT : 0, i % 60 < 40 };
+            simulation.step(input, FIXED_TIMESTEP);
+        }
+    });
+}
+
+static void benchRollouts()
+{
+    std::vector<unsigned int> level = makeLevel(30, 15);
+    Map map(30, 15, level.data(), TILE_SIZE, { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 });
+
+    const int EPISODES = 4096;
+    const int STEPS    = 600;
+
+    std::vector<LanderInput> script(STEPS);
+    for (int s = 0; s < STEPS; s++) script[s] = { (s / 20) % 3 - 1, s % 50 < 30 };
+
+    std::vector<RolloutEpisode> episodes(EPISODES);
+    for (int i = 0; i < EPISODES; i++)
+    {
+        episodes[i].position     = { 100.0f + (i % 64) * 4.0f, 80.0f + (i / 64) * 0.5f };
+        episodes[i].script       = script.data();
+        episodes[i].scriptLength = STEPS;
+    }
+
+    // Ops are lander-steps actually simulated, not episodes
+    long long landerSteps = 0;
+    {
+        RolloutRunner runner(&map, { TILE_SIZE, TILE_SIZE }, GRAVITY, 1);
+        std::vector<RolloutResult> results = runner.run(episodes, FIXED_TIMESTEP, STEPS);
+        for (size_t i = 0; i < results.size(); i++) landerSteps += results[i].steps;
+    }
+
+    for (int threads : { 1, 0 })
+    {
+        RolloutRunner runner(&map, { TILE_SIZE, TILE_SIZE }, GRAVITY, threads);
+
+        bench(threads == 1 ? "rollout_4096_single_thread" : "rollout_4096_all_threads",
+            [&](long long iterations) {
+                for (long long i = 0; i < iterations; i++)
+                    gSink = runner.run(episodes, FIXED_TIMESTEP, STEPS)[0].steps;
+            }, landerSteps);
+    }
+
+    // The same level streamed from a file in small chunks, none paged in, so
+    // every tile the landers touch is read from the file
+    const char *streamPath = "bench_streamed.lvl";
+    if (!writeLevelFile(streamPath, 30, 15, level.data(), 8))
+    {
+        printf("%s: could not be written\n", streamPath);
+        return;
+    }
+
+    {
+        Map streamed(streamPath, TILE_SIZE, map.getOrigin());
+        RolloutRunner inMemory(&map, { TILE_SIZE, TILE_SIZE }, GRAVITY, 1);
+        RolloutRunner runner(&streamed, { TILE_SIZE, TILE_SIZE }, GRAVITY, 0);
+
+        std::vector<RolloutResult> expected = inMemory.run(episodes, FIXED_TIMESTEP, STEPS);
+        std::vector<RolloutResult> results  = runner.run(episodes, FIXED_TIMESTEP, STEPS);
+        for (int i = 0; i < EPISODES; i++)
+        {
+            if (results[i].outcome != expected[i].outcome || results[i].steps != expected[i].steps)
+            {
+                printf("rollout_4096_streamed: episode %d differs from the in-memory map\n", i);
+                break;
+            }
+        }
+
+        bench("rollout_4096_streamed", [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++)
+                gSink = runner.run(episodes, FIXED_TIMESTEP, STEPS)[0].steps;
+        }, landerSteps);
+    }
+
+    remove(streamPath);
+}
+
+static void benchMapRender()
+{
+    const int SIZES[][2] = { { 30, 15 }, { 256, 256 }, { 2048, 2048 } };
+
+    for (const auto &size : SIZES)
+    {
+        std::vector<unsigned int> level = makeLevel(size[0], size[1]);
+        Map map(size[0], size[1], level.data(), "assets/game/tilesheet.png",
+            TILE_SIZE, 4, 1, { 0.0f, 0.0f });
+
+        Camera2D camera = {};
+        camera.offset = { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+        camera.zoom   = 1.0f;
+        Rectangle view = { -SCREEN_WIDTH / 2, -SCREEN_HEIGHT / 2,
+            SCREEN_WIDTH, SCREEN_HEIGHT };
+
+        // Bake the visible chunks outside the timed loop and outside Mode2D
+        BeginDrawing();
+        map.render(view);
+        EndDrawing();
+
+        char name[64];
+        snprintf(name, sizeof(name), "map_render_%dx%d", size[0], size[1]);
+
+        bench(name, [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++)
+            {
+                BeginDrawing();
+                ClearBackground(BLACK);
+                BeginMode2D(camera);
+                map.render(view);
+                EndMode2D();
+                EndDrawing();
+            }
+        });
+    }
+}
+
+/**
+ * @brief One frame of the game as main.cpp runs it: a fixed step, sprite
+ * sync, then the map, both sprites and the HUD drawn and presented.
+ */
+static void benchFrame()
+{
+    std::vector<unsigned int> level = makeLevel(30, 15);
+    Vector2 origin = { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 };
+    Vector2 start  = { origin.x - 300.0f, origin.y - 200.0f };
+
+    Map *map = new Map(30, 15, level.data(), "assets/game/tilesheet.png",
+        TILE_SIZE, 4, 1, origin);
+    Entity rockey(start, { TILE_SIZE, TILE_SIZE }, "assets/game/rockey.png", PLAYER);
+    Entity ufo({ 300.0f, origin.y }, { TILE_SIZE * 2.0f, TILE_SIZE * 2.0f },
+        "assets/game/UFO.png", UFO);
+    Simulation simulation(map, start, rockey.getScale(), ufo.getPosition(),
+        ufo.getColliderDimensions(), GRAVITY);
+
+    // time the real sprites, not the placeholders drawn while they decode
+    waitForTextures();
+
+    bench("frame", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++)
+        {
+            if (simulation.isGameOver()) simulation.reset(start);
+
+            LanderInput input = { i % 90 < 30 ? ROTATE_LEFT : 0, i % 60 < 40 };
+            simulation.step(input, FIXED_TIMESTEP);
+
+            const LanderState &lander = simulation.getLander();
+            rockey.setPosition(lander.position);
+            rockey.setAngle(lander.angle);
+            ufo.setPosition(simulation.getUfo().position);
+
+            BeginDrawing();
+            ClearBackground(BLACK);
+            rockey.render();
+            ufo.render();
+            map->render();
+            DrawText(TextFormat("Fuel: %.2f", lander.fuel), 100, 80, 20, RED);
+            EndDrawing();
+        }
+    });
+}
+
+/* ----------- OUTPUT ----------- */
+
+static bool writeJson(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return false;
+
+    fprintf(file, "[\n");
+    for (size_t i = 0; i < gResults.size(); i++)
+        fprintf(file, "  {\"name\": \"%s\", \"ns_per_op\": %.3f, \"ops\": %lld}%s\n",
+            gResults[i].name.c_str(), gResults[i].nsPerOp, gResults[i].ops,
+            i + 1 < gResults.size() ? "," : "");
+    fprintf(file, "]\n");
+
+    return fclose(file) == 0;
+}
+
+static bool writeCsv(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) return false;
+
+    fprintf(file, "name,ns_per_op,ops\n");
+    for (size_t i = 0; i < gResults.size(); i++)
+        fprintf(file, "%s,%.3f,%lld\n", gResults[i].name.c_str(),
+            gResults[i].nsPerOp, gResults[i].ops);
+
+    return fclose(file) == 0;
+}
+
+/**
+ * @brief Reads back a file written by `writeJson` (one result per line).
+ */
+static std::vector<BenchResult> readJson(const char *path)
+{
+    std::vector<BenchResult> results;
+
+    FILE *file = fopen(path, "r");
+    if (file == nullptr) return results;
+
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr)
+    {
+        char name[256];
+        double nsPerOp;
+        long long ops;
+
+        if (sscanf(line, " {\"name\": \"%255[^\"]\", \"ns_per_op\": %lf, \"ops\": %lld",
+                name, &nsPerOp, &ops) == 3)
+        {
+            BenchResult result = { name, nsPerOp, ops };
+            results.push_back(result);
+        }
+    }
+
+    fclose(file);
+    return results;
+}
+
+/**
+ * @return how many benchmarks are slower than the baseline by more than
+ * `thresholdPercent`.
+ */
+static int compareToBaseline(const char *path, double thresholdPercent)
+{
+    std::vector<BenchResult> baseline = readJson(path);
+    if (baseline.empty())
+    {
+        printf("\nNo baseline at %s (make bench-baseline stores one)\n", path);
+        return 0;
+    }
+
+    int regressions = 0;
+    printf("\n%-32s %12s %12s %9s\n", "benchmark", "ns/op", "baseline", "change");
+
+    for (size_t i = 0; i < gResults.size(); i++)
+    {
+        const BenchResult *base = nullptr;
+        for (size_t j = 0; j < baseline.size(); j++)
+            if (baseline[j].name == gResults[i].name) base = &baseline[j];
+
+        if (base == nullptr)
+        {
+            printf("%-32s %12.2f %12s %9s\n", gResults[i].name.c_str(),
+                gResults[i].nsPerOp, "-", "new");
+            continue;
+        }
+
+        double change = (gResults[i].nsPerOp / base->nsPerOp - 1.0) * 100.0;
+        bool   regressed = change > thresholdPercent;
+        if (regressed) regressions++;
+
+        printf("%-32s %12.2f %12.2f %+8.1f%%%s\n", gResults[i].name.c_str(),
+            gResults[i].nsPerOp, base->nsPerOp, change, regressed ? "  SLOWER" : "");
+    }
+
+    return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *jsonPath     = nullptr;
+    const char *csvPath      = nullptr;
+    const char *baselinePath = nullptr;
+    double      threshold    = 15.0;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if      (strcmp(argv[i], "--json") == 0)      jsonPath     = argv[i + 1];
+        else if (strcmp(argv[i], "--csv") == 0)       csvPath      = argv[i + 1];
+        else if (strcmp(argv[i], "--baseline") == 0)  baselinePath = argv[i + 1];
+        else if (strcmp(argv[i], "--threshold") == 0) threshold    = atof(argv[i + 1]);
+        else if (strcmp(argv[i], "--filter") == 0)    gFilter      = argv[i + 1];
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "bench");
+
+    benchPhysics();
+    benchRollouts();
+    benchMapRender();
+    benchFrame();
+
+    shutdownTextureCache();
+    CloseWindow();
+
+    if (jsonPath != nullptr && !writeJson(jsonPath))
+        printf("could not write %s\n", jsonPath);
+    if (csvPath != nullptr && !writeCsv(csvPath))
+        printf("could not write %s\n", csvPath);
+
+    int regressions = baselinePath != nullptr ?
+        compareToBaseline(baselinePath, threshold) : 0;
+    if (regressions > 0)
+        printf("\n%d benchmark(s) more than %.0f%% slower than the baseline\n",
+            regressions, threshold);
+
+    return regressions > 0 ? 1 : 0;
+}
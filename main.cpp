@@ -9,12 +9,50 @@
 **/
 
 #include "CS3113/Entity.h"
+#include "CS3113/SimulationThread.h"
+#include "CS3113/Replay.h"
+#include "CS3113/Autopilot.h"
+#include "CS3113/Profiler.h"
+#include "CS3113/LevelGenerator.h"
+#include "CS3113/LevelFile.h"
+#include "CS3113/ParticleSystem.h"
+#include "CS3113/GhostRenderer.h"
+#include "CS3113/EntityPool.h"
+#include "CS3113/LevelWatcher.h"
+#include <chrono>
+#include <stdlib.h>
+#include <string.h>
 
 struct GameState
 {
-    Entity *rockey;
-    Entity *ufo;
+    EntityPool   entities;
+    EntityHandle rockey;
+    EntityHandle ufo;
     Map *map;
+    std::vector<unsigned int> levelTiles; // the map's tiles, which it edits in place
+    LevelWatcher levelWatcher;            // --level only
+
+    Simulation *simulation;
+    LanderInput input;
+
+    SimulationThread *simulationThread; // --threaded only
+    LanderInput sentInput;              // last input the thread was sent
+    int lastStepCount;
+
+    Autopilot *autopilot;
+    bool autopilotOn;
+
+    ParticleSystem *particles;
+    bool crashed; // the crash burst has been emitted
+
+    LanderBatch   *ghosts;             // --ghosts only
+    GhostRenderer *ghostRenderer;
+    std::vector<LanderInput> ghostInputs;
+
+    ReplayRecorder recorder;
+
+    int  stepsThisFrame;
+    bool showProfiler;
 };
 
 // Global Constants
@@ -24,14 +62,22 @@ constexpr int SCREEN_WIDTH  = 1000,
 
 constexpr char    BG_COLOUR[]      = "#000000ff";
 constexpr Vector2 ORIGIN           = { SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2 },
-                  ATLAS_DIMENSIONS = { 6, 8 };
+                  ATLAS_DIMENSIONS = { 6, 8 },
+                  LANDER_START     = { ORIGIN.x - 300.0f, ORIGIN.y - 200.0f };
 
 constexpr float TILE_DIMENSION          = 40.0f,
                 // in m/ms², since delta time is in ms
                 ACCELERATION_OF_GRAVITY = 10.0f,
                 FIXED_TIMESTEP          = 1.0f / 60.0f,
                 END_GAME_THRESHOLD      = 800.0f,
-                ALIEN_X                 = 300.0f;
+                ALIEN_X                 = 300.0f,
+                AUTOPILOT_BUDGET        = 0.003f; // s of planning per frame
+
+constexpr int   GENERATOR_SOLVE_LIMIT = 2000; // beam layers of autopilot per generated level
+constexpr int   PARTICLE_CAPACITY     = 65536;
+
+constexpr char REPLAY_FILEPATH[] = "last_run.rpl",
+               TRACE_FILEPATH[]  = "profile_trace.json";
 
 constexpr int LEVEL_WIDTH  = 30,
               LEVEL_HEIGHT = 15;
@@ -57,6 +103,12 @@ constexpr unsigned int LEVEL_DATA[] = {
 AppStatus gAppStatus   = RUNNING;
 float gPreviousTicks   = 0.0f,
       gTimeAccumulator = 0.0f;
+bool  gFixedPoint      = false, // --fixed-point: bit-identical on every build
+      gThreaded        = false, // --threaded: simulation on its own thread
+      gAutopilot       = false; // --autopilot: start with the autopilot flying
+int   gGhostCount      = 0;     // --ghosts N: random landers flying alongside
+const char *gLevelPath = nullptr; // --level FILE: play FILE, reloading it on save
+bool  gStreamLevel     = false; // --stream FILE: page FILE in from disk instead
 
 GameState gState;
 
@@ -65,7 +117,13 @@ void initialise();
 void processInput();
 void update();
 void render();
+void updateParticles(const LanderState &lander);
+void stepGhosts(const UfoState &ufo);
+void loadLevel(int *columns, int *rows, std::vector<unsigned int> *tiles);
+void reloadLevel();
 void shutdown();
+int  replay(const char *filePath);
+int  generate(int count, uint64_t firstSeed);
 
 void initialise()
 {
@@ -73,14 +131,41 @@ void initialise()
     /*
         ----------- MAP -----------
     */
-    gState.map = new Map(
-        LEVEL_WIDTH, LEVEL_HEIGHT,   // map grid cols & rows
-        (unsigned int *) LEVEL_DATA, // grid data
-        "assets/game/tilesheet.png", // texture filepath
-        TILE_DIMENSION,              // tile size
-        4, 1,                        // texture cols & rows
-        ORIGIN                       // in-game origin
-    );
+    // A streamed level only keeps the chunks round the lander and the camera
+    // in memory; it is not reloaded on save
+    gState.map = nullptr;
+    if (gStreamLevel)
+    {
+        gState.map = new Map(gLevelPath, "assets/game/tilesheet.png",
+            TILE_DIMENSION, 4, 1, ORIGIN);
+
+        if (!gState.map->isStreamed())
+        {
+            printf("%s: not a .lvl file, playing the built-in level\n", gLevelPath);
+            delete gState.map;
+            gState.map   = nullptr;
+            gLevelPath   = nullptr;
+            gStreamLevel = false;
+        }
+    }
+
+    if (gState.map == nullptr)
+    {
+        int levelColumns, levelRows;
+        loadLevel(&levelColumns, &levelRows, &gState.levelTiles);
+
+        gState.map = new Map(
+            levelColumns, levelRows,     // map grid cols & rows
+            gState.levelTiles.data(),    // grid data
+            "assets/game/tilesheet.png", // texture filepath
+            TILE_DIMENSION,              // tile size
+            4, 1,                        // texture cols & rows
+            ORIGIN                       // in-game origin
+        );
+    }
+    gState.map->setDistanceFields(true); // the autopilot steers by them
+
+    if (gLevelPath != nullptr && !gStreamLevel) gState.levelWatcher.watch(gLevelPath);
 
     /*
         ----------- PROTAGONIST -----------
@@ -88,53 +173,146 @@ void initialise()
     float sizeRatio  = 48.0f / 64.0f;
 
     // Assets from @see https://sscary.itch.io/the-adventurer-female
-    gState.rockey = new Entity(
-        {ORIGIN.x - 300.0f, ORIGIN.y - 200.0f},     // position
+    gState.rockey = gState.entities.spawn(Entity(
+        LANDER_START,                               // position
         {TILE_DIMENSION, TILE_DIMENSION},           // scale
         "assets/game/rockey.png",                   // texture file address
         PLAYER                                      // entity type
-    );
+    ));
 
-    gState.ufo = new Entity(
+    gState.ufo = gState.entities.spawn(Entity(
         {ALIEN_X, ORIGIN.y},                       // position
         {TILE_DIMENSION*2.0f, TILE_DIMENSION*2.0f}, // scale
         "assets/game/UFO.png",                      // texture file address
         UFO                                         // entity type
-    );
+    ));
+
+    Entity *rockey = gState.entities.get(gState.rockey);
+    Entity *ufo    = gState.entities.get(gState.ufo);
 
-    gState.rockey->setColliderDimensions({
-        gState.rockey->getScale().x,
-        gState.rockey->getScale().y 
+    rockey->setColliderDimensions({
+        rockey->getScale().x,
+        rockey->getScale().y 
     });
-    gState.rockey->setAcceleration({0.0f, ACCELERATION_OF_GRAVITY});
+    rockey->setAcceleration({0.0f, ACCELERATION_OF_GRAVITY});
+
+    /*
+        ----------- SIMULATION -----------
+        The entities above are only sprites; the simulation owns the map and
+        all of the physics state.
+    */
+    gState.simulation = new Simulation(
+        gState.map,                          // map (owned by the simulation)
+        rockey->getPosition(),        // lander start
+        rockey->getScale(),           // lander collider
+        ufo->getPosition(),           // ufo start
+        ufo->getColliderDimensions(), // ufo collider
+        ACCELERATION_OF_GRAVITY              // gravity
+    );
+
+    gState.simulation->setFixedPoint(gFixedPoint);
+    gState.recorder.begin(*gState.simulation, FIXED_TIMESTEP);
+
+    // The autopilot plans on this thread, between the fixed steps it flies
+    gState.autopilot = new Autopilot(gState.map, rockey->getScale(),
+        ACCELERATION_OF_GRAVITY, FIXED_TIMESTEP);
+    gState.autopilot->setUfo(gState.simulation->getUfo());
+    gState.autopilotOn = gAutopilot && !gThreaded;
+
+    gState.particles = new ParticleSystem(PARTICLE_CAPACITY);
+    gState.crashed   = false;
+
+    // Ghosts start scattered round the lander and fly at random
+    if (gGhostCount > 0)
+    {
+        gState.ghosts = new LanderBatch(gState.map, rockey->getScale(),
+            ACCELERATION_OF_GRAVITY);
+        for (int i = 0; i < gGhostCount; i++)
+            gState.ghosts->add(Vector2 {
+                rockey->getPosition().x + GetRandomValue(-60, 60),
+                rockey->getPosition().y + GetRandomValue(-30, 30) });
+
+        gState.ghostInputs.assign(gGhostCount, LanderInput { 0, false });
+        gState.ghostRenderer = new GhostRenderer(rockey->getTexture(),
+            rockey->getScale(), gGhostCount);
+    }
+
+    if (gThreaded)
+    {
+        gState.simulationThread = new SimulationThread(gState.simulation,
+            FIXED_TIMESTEP, &gState.recorder);
+        gState.simulationThread->start();
+    }
+
+    setProfilerEnabled(true);
 
     SetTargetFPS(FPS);
 }
 
 void processInput() 
 {
-    gState.rockey -> resetMovement();
-    gState.rockey -> setAcceleration({0, ACCELERATION_OF_GRAVITY});
+    PROFILE_SCOPE(ZONE_INPUT);
+
+    gState.input = { 0, false };
 
-    if      (IsKeyDown(KEY_A)) gState.rockey->rotateLeft();
-    else if (IsKeyDown(KEY_D)) gState.rockey->rotateRight();
+    if      (IsKeyDown(KEY_A)) gState.input.rotate = ROTATE_LEFT;
+    else if (IsKeyDown(KEY_D)) gState.input.rotate = ROTATE_RIGHT;
 
     if (IsKeyDown(KEY_W))
     {
-        gState.rockey->boost();
+        gState.input.boost = true;
     }
 
+    // the thread holds on to its last input, so only changes are sent
+    if (gState.simulationThread != nullptr &&
+        (gState.input.rotate != gState.sentInput.rotate ||
+         gState.input.boost  != gState.sentInput.boost) &&
+        gState.simulationThread->pushInput(gState.input))
+        gState.sentInput = gState.input;
+
     // if (GetLength(gState.rockey->getMovement()) > 1.0f) 
     //     gState.rockey->normaliseMovement();
 
+    // F1 shows the profiler overlay, F2 dumps the last samples as a trace
+    if (IsKeyPressed(KEY_F1)) gState.showProfiler = !gState.showProfiler;
+    if (IsKeyPressed(KEY_F2)) writeChromeTrace(TRACE_FILEPATH);
+
+    // P hands the controls to the autopilot and back
+    if (IsKeyPressed(KEY_P) && gState.simulationThread == nullptr)
+    {
+        gState.autopilotOn = !gState.autopilotOn;
+        gState.autopilot->reset();
+    }
+
     if (IsKeyPressed(KEY_Q) || WindowShouldClose()) gAppStatus = TERMINATED;
 }
 
 void update() 
 {
-    if (gState.rockey->isGameOver()){
+    PROFILE_SCOPE(ZONE_UPDATE);
+
+    Entity *rockey = gState.entities.get(gState.rockey);
+    Entity *ufo    = gState.entities.get(gState.ufo);
+
+    if (gState.simulationThread != nullptr)
+    {
+        const SimulationSnapshot &snapshot = gState.simulationThread->latest();
+
+        gState.stepsThisFrame = snapshot.stepCount - gState.lastStepCount;
+        gState.lastStepCount  = snapshot.stepCount;
+
+        for (int i = 0; i < gState.stepsThisFrame; i++) stepGhosts(snapshot.ufo);
+
+        if (snapshot.lander.position.y > END_GAME_THRESHOLD) 
+            gAppStatus = TERMINATED;
+        return;
+    }
+
+    if (gState.simulation->isGameOver()){
         return; // Don't update if game is over
     }
+    if (gState.autopilotOn) gState.autopilot->think(AUTOPILOT_BUDGET);
+
     // Delta time
     float ticks = (float) GetTime();
     float deltaTime = ticks - gPreviousTicks;
@@ -151,65 +329,354 @@ void update()
 
     while (deltaTime >= FIXED_TIMESTEP)
     {
-        gState.rockey->update(
-            FIXED_TIMESTEP, // delta time / fixed timestep
-            nullptr,        // player
-            gState.map,     // map
-            gState.ufo,     // collidable entities
-            1               // col. entity count
-        );
+        PROFILE_SCOPE(ZONE_STEP);
+        gState.stepsThisFrame++;
 
-        deltaTime -= FIXED_TIMESTEP;
+        if (gState.autopilotOn) 
+            gState.input = gState.autopilot->nextInput(*gState.simulation);
 
-        Vector2 currentPlayerPosition = { gState.rockey->getPosition().x, ORIGIN.y };
-        Vector2 alienPosition = gState.ufo->getPosition();
+        if (!gState.simulation->isGameOver()) 
+            gState.recorder.record(gState.input);
+        gState.simulation->step(gState.input, FIXED_TIMESTEP);
+        stepGhosts(gState.simulation->getUfo());
 
-        // Simple moving platform
-        gState.ufo->setPosition({
-            ALIEN_X,
-            ORIGIN.y + sin(ticks)*20.0f,
-        });
-        if (gState.rockey->getPosition().y > 800.0f) gAppStatus = TERMINATED;
+        // the sprites keep this step and the one before it to draw between
+        rockey->pushPhysicsState(gState.simulation->getLander().position,
+            gState.simulation->getLander().angle);
+        ufo->pushPhysicsState(gState.simulation->getUfo().position, 0.0f);
+
+        deltaTime -= FIXED_TIMESTEP;
+
+        if (gState.simulation->getLander().position.y > END_GAME_THRESHOLD) 
+            gAppStatus = TERMINATED;
     }
+
+    gTimeAccumulator = deltaTime;
 }
 
 void render()
 {
+    Entity *rockey = gState.entities.get(gState.rockey);
+    Entity *ufo    = gState.entities.get(gState.ufo);
+
+    const LanderState *landerState = &gState.simulation->getLander();
+
+    // how far between the last two fixed steps this frame falls
+    float interpolation = gTimeAccumulator / FIXED_TIMESTEP;
+
+    if (gState.simulationThread != nullptr)
+    {
+        const SimulationSnapshot &snapshot = gState.simulationThread->latest();
+        landerState = &snapshot.lander;
+
+        rockey->snapPhysicsState(snapshot.previousLanderPosition,
+            snapshot.previousLanderAngle);
+        rockey->pushPhysicsState(snapshot.lander.position,
+            snapshot.lander.angle);
+        ufo->snapPhysicsState(snapshot.previousUfoPosition, 0.0f);
+        ufo->pushPhysicsState(snapshot.ufo.position, 0.0f);
+
+        interpolation = gState.simulationThread->interpolation(snapshot);
+    }
+
+    const LanderState &lander = *landerState;
+
+    // nothing moves once the game is over, so stop where it ended
+    if (lander.collisionStatus != PLAYING) interpolation = 1.0f;
+
+    updateParticles(lander);
+    uploadLoadedTextures(); // sprites decoded since last frame replace placeholders
+
     BeginDrawing();
     ClearBackground(ColorFromHex(BG_COLOUR));
 
-    gState.rockey->render();
-    gState.ufo->render();
-    gState.map->render();
-    DrawText(TextFormat("Fuel: %.2f", gState.rockey->getFuel()), 100, 80, 20, RED);
+    {
+        PROFILE_SCOPE(ZONE_ENTITY_RENDER);
+        if (gState.ghosts != nullptr)
+        {
+            gState.ghostRenderer->clear();
+            gState.ghostRenderer->addLanders(*gState.ghosts);
+            gState.ghostRenderer->render();
+        }
+        gState.particles->render();
+        for (int i = 0; i < gState.entities.getActiveCount(); i++)
+            gState.entities.getActive(i).render(interpolation);
+    }
+    {
+        PROFILE_SCOPE(ZONE_MAP_RENDER);
+        gState.map->render();
+    }
+    DrawText(TextFormat("Fuel: %.2f", lander.fuel), 100, 80, 20, RED);
+    if (gState.autopilotOn) DrawText("AUTOPILOT", 100, 105, 20, YELLOW);
 
-    if (gState.rockey->isGameOver() && gState.rockey->hasWon()){
+    if (lander.collisionStatus == WIN){
         DrawText(TextFormat("Mission Accomplished"), 100, ORIGIN.y-50, 50, GREEN);
     }
-    else if (gState.rockey->isGameOver() && gState.rockey->hasLost()){
+    else if (lander.collisionStatus == LOSS){
         DrawText(TextFormat("Mission Failed"), 100, ORIGIN.y-50, 50, RED);
     }
 
+    if (gState.showProfiler) 
+        drawProfilerOverlay(SCREEN_WIDTH - PROFILE_FRAME_HISTORY - 10, 10);
+
     EndDrawing();
 }
 
+/**
+ * @brief Advances the particles by one rendered frame: exhaust while the
+ * lander thrusts, and one burst of debris when it crashes. Once per frame,
+ * not per fixed step, since nothing in the simulation depends on them.
+ */
+void updateParticles(const LanderState &lander)
+{
+    PROFILE_SCOPE(ZONE_PARTICLES);
+    float deltaTime = GetFrameTime();
+
+    if (lander.collisionStatus == PLAYING && lander.boosting && lander.fuel > 0)
+    {
+        // out of the bottom of the lander, whichever way it is pointing
+        float angleInRadians = lander.angle * PI / 180;
+        Vector2 nozzle = {
+            lander.position.x - sin(angleInRadians) * lander.colliderDimensions.y / 2,
+            lander.position.y + cos(angleInRadians) * lander.colliderDimensions.y / 2
+        };
+
+        gState.particles->emitExhaust(nozzle, lander.angle, lander.velocity,
+            deltaTime);
+    }
+
+    if (lander.collisionStatus == LOSS && !gState.crashed)
+        gState.particles->emitDebris(lander.position, lander.velocity);
+    gState.crashed = lander.collisionStatus == LOSS;
+
+    gState.particles->update(deltaTime);
+}
+
+/**
+ * @brief Advances the ghosts by one fixed step. Each keeps its action for
+ * about a quarter of a second on average before picking another at random,
+ * and crashes into the UFO where `ufo` has it.
+ */
+void stepGhosts(const UfoState &ufo)
+{
+    if (gState.ghosts == nullptr) return;
+
+    for (LanderInput &input : gState.ghostInputs)
+        if (GetRandomValue(0, 14) == 0)
+            input = landerAction(GetRandomValue(0, LANDER_ACTION_COUNT - 1));
+
+    gState.ghosts->step(gState.ghostInputs.data(), FIXED_TIMESTEP,
+        &ufo.position, &ufo.colliderDimensions, 1);
+}
+
+/**
+ * @brief Fills `tiles` from the --level file if there is one and it reads,
+ * and from the built-in level otherwise.
+ */
+void loadLevel(int *columns, int *rows, std::vector<unsigned int> *tiles)
+{
+    if (gLevelPath != nullptr)
+    {
+        if (readLevelFile(gLevelPath, columns, rows, tiles)) return;
+        printf("%s: not a level, playing the built-in one\n", gLevelPath);
+    }
+
+    *columns = LEVEL_WIDTH;
+    *rows    = LEVEL_HEIGHT;
+    tiles->assign(LEVEL_DATA, LEVEL_DATA + LEVEL_WIDTH * LEVEL_HEIGHT);
+}
+
+/**
+ * @brief Applies the latest save of the --level file, if there has been one
+ * since last frame, to the running map. Only the tiles that differ change;
+ * the lander, the UFO and the ghosts carry on from where they are. The
+ * simulation thread is paused meanwhile, as the map must not change under
+ * it. A run whose level was reloaded will not pass --replay.
+ */
+void reloadLevel()
+{
+    if (!gState.levelWatcher.hasChanged()) return;
+
+    int columns, rows;
+    std::vector<unsigned int> tiles;
+    if (!readLevelFile(gLevelPath, &columns, &rows, &tiles))
+    {
+        printf("%s: could not be read, keeping the current level\n", gLevelPath);
+        return;
+    }
+
+    if (gState.simulationThread != nullptr) gState.simulationThread->stop();
+    int changed = gState.map->reloadTiles(columns, rows, tiles.data());
+    if (gState.simulationThread != nullptr) gState.simulationThread->start();
+
+    if (changed < 0)
+    {
+        printf("%s: now %dx%d tiles, not %dx%d; restart to play it\n",
+            gLevelPath, columns, rows, gState.map->getMapColumns(),
+            gState.map->getMapRows());
+        return;
+    }
+
+    // its plan may run through tiles that are no longer there, or now are
+    if (changed > 0) gState.autopilot->reset();
+
+    printf("%s: reloaded, %d tiles changed\n", gLevelPath, changed);
+}
+
 void shutdown() 
 {
-    delete gState.rockey;
-    delete gState.map;
+    // hands the simulation and recorder back to this thread
+    delete gState.simulationThread;
+
+    saveReplay(REPLAY_FILEPATH, gState.recorder.finish(*gState.simulation));
 
+    delete gState.autopilot;
+    delete gState.particles;
+    delete gState.ghostRenderer;
+    delete gState.ghosts;
+    gState.entities.clear(); // the lander and the UFO, and their textures
+    delete gState.simulation; // also deletes gState.map
+    gState.levelWatcher.stop();
+
+    shutdownTextureCache();
     CloseWindow();
 }
 
-int main(void)
+/**
+ * @brief Re-simulates a recorded run without opening a window, as fast as it
+ * will go, and checks it ends where the recording did. Runs recorded with
+ * --level need the same level file passed again.
+ *
+ * @return the process exit code: 0 if the replay checks out.
+ */
+int replay(const char *filePath)
+{
+    Replay recording;
+    if (!loadReplay(filePath, &recording))
+    {
+        printf("%s: not a replay file\n", filePath);
+        return 1;
+    }
+
+    int columns, rows;
+    std::vector<unsigned int> tiles;
+    loadLevel(&columns, &rows, &tiles);
+
+    Simulation simulation(
+        new Map(columns, rows, tiles.data(), TILE_DIMENSION, ORIGIN),
+        recording.header.landerPosition,
+        { TILE_DIMENSION, TILE_DIMENSION },
+        { ALIEN_X, ORIGIN.y },
+        { TILE_DIMENSION * 2.0f, TILE_DIMENSION * 2.0f },
+        ACCELERATION_OF_GRAVITY
+    );
+
+    auto start = std::chrono::steady_clock::now();
+    ReplayCheck check = verifyReplay(recording, &simulation);
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    const char *results[] = { "ok", "recorded on a different level",
+        "recorded with different settings", "corrupt input stream", "desync" };
+
+    printf("%s: %u steps (%.1fs of play) replayed in %.3fms: %s\n", filePath,
+        recording.header.stepCount, 
+        recording.header.stepCount * recording.header.deltaTime,
+        seconds * 1000.0, results[check]);
+
+    return check == REPLAY_OK ? 0 : 1;
+}
+
+/**
+ * @brief Generates `count` levels the autopilot can land on, the size of
+ * the built-in one, starting from seed `firstSeed`, and writes each to
+ * level_<seed>.lvl. No window is opened.
+ *
+ * @return the process exit code: 0 if all `count` were written.
+ */
+int generate(int count, uint64_t firstSeed)
 {
+    LevelGenerator generator(LEVEL_WIDTH, LEVEL_HEIGHT);
+    generator.setSolveCheck(TILE_DIMENSION, { TILE_DIMENSION, TILE_DIMENSION },
+        ACCELERATION_OF_GRAVITY, FIXED_TIMESTEP, GENERATOR_SOLVE_LIMIT);
+
+    // the levels are played with --level, which starts the lander where the
+    // built-in level does, so that is where they are checked from
+    generator.setSpawn(
+        (int) ((LANDER_START.x - ORIGIN.x) / TILE_DIMENSION + LEVEL_WIDTH / 2.0f),
+        (int) ((LANDER_START.y - ORIGIN.y) / TILE_DIMENSION + LEVEL_HEIGHT / 2.0f));
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<GeneratedLevel> levels;
+    int generated = generator.generateMany(firstSeed, count, &levels);
+    double seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count();
+
+    int written = 0;
+    for (const GeneratedLevel &level : levels)
+    {
+        const char *filePath = TextFormat("level_%llu.lvl",
+            (unsigned long long) level.seed);
+
+        if (!writeLevelFile(filePath, level.columns, level.rows,
+            level.tiles.data()))
+        {
+            printf("%s: could not be written\n", filePath);
+            continue;
+        }
+
+        printf("%s: spawn tile (%d, %d), %.1f tiles from a pad\n", filePath,
+            level.spawnColumn, level.spawnRow, level.goalDistance);
+        written++;
+    }
+
+    printf("%d of %d levels generated in %.3fs on %d threads\n", generated,
+        count, seconds, generator.getThreadCount());
+
+    return written == count ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc >= 3 && strcmp(argv[1], "--replay") == 0)
+    {
+        if (argc == 5 && strcmp(argv[3], "--level") == 0) gLevelPath = argv[4];
+        return replay(argv[2]);
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--generate") == 0)
+        return generate(atoi(argv[2]),
+            argc == 4 ? strtoull(argv[3], nullptr, 10) : 1);
+
+    for (int i = 1; i < argc; i++)
+    {
+        if      (strcmp(argv[i], "--fixed-point") == 0) gFixedPoint = true;
+        else if (strcmp(argv[i], "--threaded") == 0)    gThreaded   = true;
+        else if (strcmp(argv[i], "--autopilot") == 0)   gAutopilot  = true;
+        else if (strcmp(argv[i], "--ghosts") == 0 && i + 1 < argc)
+            gGhostCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--level") == 0 && i + 1 < argc)
+            gLevelPath = argv[++i];
+        else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc)
+        {
+            gLevelPath   = argv[++i];
+            gStreamLevel = true;
+        }
+    }
+
     initialise();
 
     while (gAppStatus == RUNNING)
     {
-        processInput();
-        update();
-        render();
+        {
+            PROFILE_SCOPE(ZONE_FRAME);
+            gState.stepsThisFrame = 0;
+
+            reloadLevel();
+            processInput();
+            update();
+            render();
+        }
+        markProfilerFrame(gState.stepsThisFrame);
     }
 
     shutdown();